@@ -0,0 +1,83 @@
+/*
+ * Call-overhead benchmark for small strings.
+ *
+ * Build once against the linked library and once header-only, then compare:
+ *   cc -std=c99 -O2 -I.. bench_strngr.c ../strngr.c -o bench_linked
+ *   cc -std=c99 -O2 -I.. -DSTRNGR_HEADER_ONLY bench_strngr.c -o bench_inline
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include "strngr.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_ITERATIONS (20000000UL)
+#define BENCH_KEYS       (8U)
+
+#if defined(STRNGR_HEADER_ONLY)
+#define BENCH_MODE "header-only"
+#else
+#define BENCH_MODE "linked"
+#endif
+
+static const str_t bench_keys[BENCH_KEYS] = {
+    STR_T_LITERAL_INIT("Host"),       STR_T_LITERAL_INIT("Accept"),     STR_T_LITERAL_INIT("Cookie"),
+    STR_T_LITERAL_INIT("Referer"),    STR_T_LITERAL_INIT("Origin"),     STR_T_LITERAL_INIT("Pragma"),
+    STR_T_LITERAL_INIT("User-Agent"), STR_T_LITERAL_INIT("Connection"),
+};
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static void bench_report(const char *name, const double start, const uint64_t sink)
+{
+    const double ns = (bench_now() - start) / (double)BENCH_ITERATIONS;
+    printf("%-12s %-14s %6.2f ns/call (sink %llu)\n", BENCH_MODE, name, ns, (unsigned long long)sink);
+}
+
+int main(void)
+{
+    /* The keys are picked at run time so the header-only build cannot fold the calls away */
+    volatile uint32_t mask = BENCH_KEYS - 1U;
+    uint64_t          sink = 0U;
+    double            start;
+
+    start = bench_now();
+    for (uint64_t i = 0U; i < BENCH_ITERATIONS; i++)
+    {
+        sink += strngr_strlen(bench_keys[i & mask]);
+    }
+    bench_report("strlen", start, sink);
+
+    sink  = 0U;
+    start = bench_now();
+    for (uint64_t i = 0U; i < BENCH_ITERATIONS; i++)
+    {
+        sink += (uint64_t)(int64_t)strngr_strncmp(bench_keys[i & mask], bench_keys[(i >> 3) & mask], 16U);
+    }
+    bench_report("strncmp", start, sink);
+
+    sink  = 0U;
+    start = bench_now();
+    for (uint64_t i = 0U; i < BENCH_ITERATIONS; i++)
+    {
+        sink += strngr_strcspn(bench_keys[i & mask], 'e');
+    }
+    bench_report("strcspn", start, sink);
+
+    sink  = 0U;
+    start = bench_now();
+    for (uint64_t i = 0U; i < BENCH_ITERATIONS; i++)
+    {
+        sink += strngr_strsub(bench_keys[i & mask], 1, -1).len;
+    }
+    bench_report("strsub", start, sink);
+
+    return 0;
+}
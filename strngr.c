@@ -4,142 +4,4655 @@
 #include <stdint.h>
 #include <string.h>
 
-char *strngr_new(str_t *str, char *mem, const uint32_t mem_len)
+/* Scan kernels are selected at compile time from the target flags (-msse2, -mssse3, -mavx2, ...).
+ * Define STRNGR_NO_SIMD to force the portable word-at-a-time path. */
+#if !defined(STRNGR_NO_SIMD)
+#if defined(__AVX512BW__)
+#define STRNGR_AVX512
+#endif
+#if defined(__AVX512BW__) && defined(__AVX512VBMI2__)
+#define STRNGR_AVX512_VBMI2
+#endif
+#if defined(__AVX2__)
+#define STRNGR_AVX2
+#endif
+#if defined(__SSSE3__)
+#define STRNGR_SSSE3
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define STRNGR_SSE2
+#endif
+#endif
+
+#if defined(STRNGR_AVX512) || defined(STRNGR_AVX2)
+#include <immintrin.h>
+#elif defined(STRNGR_SSSE3)
+#include <tmmintrin.h>
+#elif defined(STRNGR_SSE2)
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define STRNGR_SWAR_ONES  (0x0101010101010101ULL)
+#define STRNGR_SWAR_HIGHS (0x8080808080808080ULL)
+
+static uint32_t strngr_ctz32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(v);
+#elif defined(_MSC_VER)
+    unsigned long idx = 0UL;
+    (void)_BitScanForward(&idx, (unsigned long)v);
+    return (uint32_t)idx;
+#else
+    uint32_t n = 0U;
+    while ((v & 1U) == 0U)
+    {
+        v >>= 1U;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static uint32_t strngr_ctz64(uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(v);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long idx = 0UL;
+    (void)_BitScanForward64(&idx, v);
+    return (uint32_t)idx;
+#else
+    const uint32_t lo = (uint32_t)v;
+    return (lo != 0U) ? strngr_ctz32(lo) : (32U + strngr_ctz32((uint32_t)(v >> 32U)));
+#endif
+}
+
+/* Index of the highest set bit (v != 0); only the vector kernels scan backwards by mask */
+#if defined(STRNGR_SSE2)
+static uint32_t strngr_msb32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 31U - (uint32_t)__builtin_clz(v);
+#elif defined(_MSC_VER)
+    unsigned long idx = 0UL;
+    (void)_BitScanReverse(&idx, (unsigned long)v);
+    return (uint32_t)idx;
+#else
+    uint32_t n = 0U;
+    while ((v >>= 1U) != 0U)
+    {
+        n++;
+    }
+    return n;
+#endif
+}
+#endif
+
+#if defined(STRNGR_AVX512)
+static uint32_t strngr_msb64(uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63U - (uint32_t)__builtin_clzll(v);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long idx = 0UL;
+    (void)_BitScanReverse64(&idx, v);
+    return (uint32_t)idx;
+#else
+    const uint32_t hi = (uint32_t)(v >> 32U);
+    return (hi != 0U) ? (32U + strngr_msb32(hi)) : strngr_msb32((uint32_t)v);
+#endif
+}
+#endif
+
+static uint32_t strngr_popcount64(uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcountll(v);
+#else
+    v = v - ((v >> 1U) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2U) & 0x3333333333333333ULL);
+    v = (v + (v >> 4U)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (uint32_t)((v * STRNGR_SWAR_ONES) >> 56U);
+#endif
+}
+
+/* Little-endian reads, for results that do not depend on the host byte order */
+static uint64_t strngr_load_le64(const uint8_t *p)
+{
+    uint64_t v = 0U;
+    memcpy((void *)&v, (const void *)p, sizeof(v));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static uint64_t strngr_load_le32(const uint8_t *p)
+{
+    uint32_t v = 0U;
+    memcpy((void *)&v, (const void *)p, sizeof(v));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap32(v);
+#endif
+    return (uint64_t)v;
+}
+
+#if !defined(STRNGR_SSE2)
+static uint64_t strngr_load64(const char *p)
+{
+    uint64_t v = 0U;
+    memcpy((void *)&v, (const void *)p, sizeof(v));
+    return v;
+}
+
+/* Non-zero if any byte of v is zero (no false negatives, exact for the lowest zero byte) */
+static uint64_t strngr_swar_has_zero(const uint64_t v)
+{
+    return (v - STRNGR_SWAR_ONES) & ~v & STRNGR_SWAR_HIGHS;
+}
+#endif
+
+/* Bit i set where p[i] == c, over 64 bytes */
+static uint64_t strngr_mask64(const char *p, const char c)
+{
+#if defined(STRNGR_AVX512)
+    return (uint64_t)_mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)p), _mm512_set1_epi8(c));
+#elif defined(STRNGR_AVX2)
+    const __m256i  v  = _mm256_set1_epi8(c);
+    const uint64_t lo = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)p), v));
+    const uint64_t hi =
+        (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)&p[32]), v));
+    return lo | (hi << 32U);
+#elif defined(STRNGR_SSE2)
+    const __m128i v = _mm_set1_epi8(c);
+    uint64_t      m = 0U;
+    for (uint32_t k = 0U; k < 4U; k++)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i *)&p[k * 16U]);
+        m |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, v)) << (k * 16U);
+    }
+    return m;
+#else
+    /* Exact per-byte zero test, then the multiply gathers the eight flag bits into the top byte */
+    const uint64_t pattern = STRNGR_SWAR_ONES * (uint64_t)(uint8_t)c;
+    const uint64_t lows    = 0x7F7F7F7F7F7F7F7FULL;
+    uint64_t       m       = 0U;
+    for (uint32_t k = 0U; k < 8U; k++)
+    {
+        const uint64_t x = strngr_load_le64((const uint8_t *)&p[k * 8U]) ^ pattern;
+        const uint64_t z = ~(((x & lows) + lows) | x | lows);
+        m |= (((z >> 7U) * 0x0102040810204080ULL) >> 56U) << (k * 8U);
+    }
+    return m;
+#endif
+}
+
+/* Number of bytes equal to c in s[0..len): population count of the 64-byte compare masks */
+static uint32_t strngr_count_byte(const char *s, const uint32_t len, const char c)
+{
+    uint32_t n = 0U;
+    uint32_t i = 0U;
+
+    for (; (len - i) >= 64U; i += 64U)
+    {
+        n += strngr_popcount64(strngr_mask64(&s[i], c));
+    }
+    for (; i < len; i++)
+    {
+        n += (s[i] == c) ? 1U : 0U;
+    }
+
+    return n;
+}
+
+/* Index of the first byte equal to c in s[0..len), or len if there is none */
+static uint32_t strngr_find_byte(const char *s, const uint32_t len, const char c)
+{
+    uint32_t i = 0U;
+
+#if defined(STRNGR_AVX512)
+    const __m512i v512 = _mm512_set1_epi8(c);
+    for (; (len - i) >= 64U; i += 64U)
+    {
+        const uint64_t m = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)&s[i]), v512);
+        if (m != 0U)
+        {
+            return i + strngr_ctz64(m);
+        }
+    }
+#endif
+
+#if defined(STRNGR_AVX2)
+    const __m256i v256 = _mm256_set1_epi8(c);
+    for (; (len - i) >= 32U; i += 32U)
+    {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i *)&s[i]);
+        const uint32_t m    = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, v256));
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+#endif
+
+#if defined(STRNGR_SSE2)
+    const __m128i v128 = _mm_set1_epi8(c);
+    for (; (len - i) >= 16U; i += 16U)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i *)&s[i]);
+        const uint32_t m    = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, v128));
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+#else
+    /* Word-at-a-time: XOR with the broadcast byte turns matches into zero bytes */
+    const uint64_t pattern = STRNGR_SWAR_ONES * (uint64_t)(uint8_t)c;
+    for (; (len - i) >= 8U; i += 8U)
+    {
+        if (strngr_swar_has_zero(strngr_load64(&s[i]) ^ pattern) != 0U)
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        if (s[i] == c)
+        {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+/* Index of the last byte equal to c in s[0..len), or len if there is none. Blocks are loaded from the end and the
+ * highest set bit of the compare mask is the match. */
+static uint32_t strngr_find_byte_last(const char *s, const uint32_t len, const char c)
+{
+    uint32_t i = len;
+
+#if defined(STRNGR_AVX512)
+    const __m512i v512 = _mm512_set1_epi8(c);
+    for (; i >= 64U; i -= 64U)
+    {
+        const uint64_t m = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void *)&s[i - 64U]), v512);
+        if (m != 0U)
+        {
+            return (i - 64U) + strngr_msb64(m);
+        }
+    }
+#endif
+
+#if defined(STRNGR_AVX2)
+    const __m256i v256 = _mm256_set1_epi8(c);
+    for (; i >= 32U; i -= 32U)
+    {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i *)&s[i - 32U]);
+        const uint32_t m    = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, v256));
+        if (m != 0U)
+        {
+            return (i - 32U) + strngr_msb32(m);
+        }
+    }
+#endif
+
+#if defined(STRNGR_SSE2)
+    const __m128i v128 = _mm_set1_epi8(c);
+    for (; i >= 16U; i -= 16U)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i *)&s[i - 16U]);
+        const uint32_t m    = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, v128));
+        if (m != 0U)
+        {
+            return (i - 16U) + strngr_msb32(m);
+        }
+    }
+#else
+    /* Word-at-a-time; the zero test can over-report above a match, so the byte loop locates it */
+    const uint64_t pattern = STRNGR_SWAR_ONES * (uint64_t)(uint8_t)c;
+    for (; i >= 8U; i -= 8U)
+    {
+        if (strngr_swar_has_zero(strngr_load64(&s[i - 8U]) ^ pattern) != 0U)
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; i > 0U; i--)
+    {
+        if (s[i - 1U] == c)
+        {
+            return i - 1U;
+        }
+    }
+
+    return len;
+}
+
+/* Index of the first byte where a[0..n) and b[0..n) differ, or n if they are equal */
+static uint32_t strngr_mismatch(const char *a, const char *b, const uint32_t n)
+{
+    uint32_t i = 0U;
+
+#if defined(STRNGR_AVX2)
+    for (; (n - i) >= 32U; i += 32U)
+    {
+        const __m256i va = _mm256_loadu_si256((const __m256i *)&a[i]);
+        const __m256i vb = _mm256_loadu_si256((const __m256i *)&b[i]);
+        const uint32_t m = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+#endif
+
+#if defined(STRNGR_SSE2)
+    for (; (n - i) >= 16U; i += 16U)
+    {
+        const __m128i va = _mm_loadu_si128((const __m128i *)&a[i]);
+        const __m128i vb = _mm_loadu_si128((const __m128i *)&b[i]);
+        const uint32_t m = 0xFFFFU ^ (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+#else
+    /* Word-at-a-time: stop on the first word that differs and let the byte loop locate it */
+    for (; (n - i) >= 8U; i += 8U)
+    {
+        if (strngr_load64(&a[i]) != strngr_load64(&b[i]))
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        if (a[i] != b[i])
+        {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+/* ASCII case folding: 'A'..'Z' become 'a'..'z', every other byte is unchanged */
+static uint8_t strngr_fold_byte(const uint8_t b)
+{
+    return (uint8_t)(b | ((((uint8_t)(b - (uint8_t)'A')) < 26U) ? 0x20U : 0U));
+}
+
+/* Flip bit 0x20 of the bytes in first..first + 25 ('A' to lower-case them, 'a' to upper-case them), eight at a
+ * time: the high bit of each lane flags first <= b and b <= first + 25 without carries between lanes */
+static uint64_t strngr_flip64(const uint64_t v, const uint8_t first)
+{
+    const uint64_t low   = v & 0x7F7F7F7F7F7F7F7FULL;
+    const uint64_t ge    = low + (STRNGR_SWAR_ONES * (uint64_t)(0x80U - (uint32_t)first));
+    const uint64_t gt    = low + (STRNGR_SWAR_ONES * (uint64_t)(0x80U - 26U - (uint32_t)first));
+    const uint64_t range = ge & ~gt & ~v & STRNGR_SWAR_HIGHS;
+    return v ^ (range >> 2U);
+}
+
+static uint64_t strngr_fold64(const uint64_t v)
+{
+    return strngr_flip64(v, (uint8_t)'A');
+}
+
+#if defined(STRNGR_SSE2)
+/* Offset so that first..first + 25 are the 26 smallest signed bytes, then flip 0x20 in those lanes */
+static __m128i strngr_flip128(const __m128i v, const uint8_t first)
+{
+    const __m128i x     = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80U - (uint32_t)first)));
+    const __m128i range = _mm_cmpgt_epi8(_mm_set1_epi8((char)(-128 + 26)), x);
+    return _mm_xor_si128(v, _mm_and_si128(range, _mm_set1_epi8(0x20)));
+}
+
+static __m128i strngr_fold128(const __m128i v)
+{
+    return strngr_flip128(v, (uint8_t)'A');
+}
+#endif
+
+#if defined(STRNGR_AVX2)
+static __m256i strngr_flip256(const __m256i v, const uint8_t first)
+{
+    const __m256i x     = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80U - (uint32_t)first)));
+    const __m256i range = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(-128 + 26)), x);
+    return _mm256_xor_si256(v, _mm256_and_si256(range, _mm256_set1_epi8(0x20)));
+}
+
+static __m256i strngr_fold256(const __m256i v)
+{
+    return strngr_flip256(v, (uint8_t)'A');
+}
+#endif
+
+/* strngr_mismatch ignoring ASCII case: both sides are folded in registers as they are compared */
+static uint32_t strngr_mismatch_nocase(const char *a, const char *b, const uint32_t n)
+{
+    uint32_t i = 0U;
+
+#if defined(STRNGR_AVX2)
+    for (; (n - i) >= 32U; i += 32U)
+    {
+        const __m256i va = strngr_fold256(_mm256_loadu_si256((const __m256i *)&a[i]));
+        const __m256i vb = strngr_fold256(_mm256_loadu_si256((const __m256i *)&b[i]));
+        const uint32_t m = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+#endif
+
+#if defined(STRNGR_SSE2)
+    for (; (n - i) >= 16U; i += 16U)
+    {
+        const __m128i va = strngr_fold128(_mm_loadu_si128((const __m128i *)&a[i]));
+        const __m128i vb = strngr_fold128(_mm_loadu_si128((const __m128i *)&b[i]));
+        const uint32_t m = 0xFFFFU ^ (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+#else
+    for (; (n - i) >= 8U; i += 8U)
+    {
+        if (strngr_fold64(strngr_load64(&a[i])) != strngr_fold64(strngr_load64(&b[i])))
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        if (strngr_fold_byte((uint8_t)a[i]) != strngr_fold_byte((uint8_t)b[i]))
+        {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+/* dst[i] = src[i] with the letters first..first + 25 case-flipped, for i < len; dst may be src */
+static void strngr_flip_bytes(const char *src, char *dst, const uint32_t len, const uint8_t first)
+{
+    uint32_t i = 0U;
+
+#if defined(STRNGR_AVX2)
+    for (; (len - i) >= 32U; i += 32U)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)&src[i]);
+        _mm256_storeu_si256((__m256i *)&dst[i], strngr_flip256(v, first));
+    }
+#endif
+
+#if defined(STRNGR_SSE2)
+    for (; (len - i) >= 16U; i += 16U)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i *)&src[i]);
+        _mm_storeu_si128((__m128i *)&dst[i], strngr_flip128(v, first));
+    }
+#else
+    for (; (len - i) >= 8U; i += 8U)
+    {
+        const uint64_t v = strngr_flip64(strngr_load64(&src[i]), first);
+        memcpy((void *)&dst[i], (const void *)&v, sizeof(v));
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        const uint8_t b = (uint8_t)src[i];
+        dst[i] = (char)((((uint8_t)(b - first)) < 26U) ? (b ^ 0x20U) : b);
+    }
+}
+
+/* dst[i] = tr->map[src[i]] for i < len; dst may be src. With SSSE3 each 16-byte row of the map that is not the
+ * identity is applied with one shuffle, selected by the high nibble, so sparse tables cost a few rows per block. */
+static void strngr_tr_bytes(const char *src, char *dst, const uint32_t len, const strngr_tr_t *tr)
+{
+    uint32_t i = 0U;
+
+#if defined(STRNGR_AVX2)
+    const __m256i nib256 = _mm256_set1_epi8(0x0F);
+    for (; (len - i) >= 32U; i += 32U)
+    {
+        const __m256i v  = _mm256_loadu_si256((const __m256i *)&src[i]);
+        const __m256i lo = _mm256_and_si256(v, nib256);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nib256);
+        __m256i       r  = v;
+        for (uint32_t rows = tr->rows; rows != 0U; rows &= rows - 1U)
+        {
+            const uint32_t h   = strngr_ctz32(rows);
+            const __m256i  lut = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)&tr->map[h * 16U]));
+            r = _mm256_blendv_epi8(r, _mm256_shuffle_epi8(lut, lo), _mm256_cmpeq_epi8(hi, _mm256_set1_epi8((char)h)));
+        }
+        _mm256_storeu_si256((__m256i *)&dst[i], r);
+    }
+#endif
+
+#if defined(STRNGR_SSSE3)
+    const __m128i nib128 = _mm_set1_epi8(0x0F);
+    for (; (len - i) >= 16U; i += 16U)
+    {
+        const __m128i v  = _mm_loadu_si128((const __m128i *)&src[i]);
+        const __m128i lo = _mm_and_si128(v, nib128);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nib128);
+        __m128i       r  = v;
+        for (uint32_t rows = tr->rows; rows != 0U; rows &= rows - 1U)
+        {
+            const uint32_t h   = strngr_ctz32(rows);
+            const __m128i  sel = _mm_cmpeq_epi8(hi, _mm_set1_epi8((char)h));
+            const __m128i  out = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&tr->map[h * 16U]), lo);
+            r = _mm_or_si128(_mm_andnot_si128(sel, r), _mm_and_si128(sel, out));
+        }
+        _mm_storeu_si128((__m128i *)&dst[i], r);
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        dst[i] = (char)tr->map[(uint8_t)src[i]];
+    }
+}
+
+/* Needles up to this length go through the first/last byte candidate filter */
+#define STRNGR_SHORT_NEEDLE_MAX (32U)
+
+/* The candidate filter gives up and switches to Two-Way once verification exceeds this many bytes per haystack byte */
+#define STRNGR_VERIFY_BUDGET (4U)
+
+/* Two-Way needle modes: run backwards over the mirror image, and/or compare ASCII case-folded bytes */
+#define STRNGR_TW_MIRROR (0x1U)
+#define STRNGR_TW_FOLD   (0x2U)
+
+/* Byte i of n[0..len) as seen in the given mode */
+static uint8_t strngr_tw_at(const uint8_t *n, const uint32_t len, const uint32_t i, const uint32_t mode)
+{
+    const uint8_t b = n[((mode & STRNGR_TW_MIRROR) != 0U) ? (len - 1U - i) : i];
+    return ((mode & STRNGR_TW_FOLD) != 0U) ? strngr_fold_byte(b) : b;
+}
+
+/* Start of the maximal suffix of n[0..len) (as seen in mode) under the byte order selected by rev, and its period */
+static uint32_t strngr_max_suffix(const uint8_t *n, const uint32_t len, const uint32_t rev, const uint32_t mode,
+                                  uint32_t *period)
+{
+    /* ip starts at -1 and relies on unsigned wrap so that ip + k indexes from 0 */
+    uint32_t ip = UINT32_MAX;
+    uint32_t jp = 0U;
+    uint32_t k  = 1U;
+    uint32_t p  = 1U;
+
+    while ((jp + k) < len)
+    {
+        const uint8_t a = strngr_tw_at(n, len, ip + k, mode);
+        const uint8_t b = strngr_tw_at(n, len, jp + k, mode);
+
+        if (a == b)
+        {
+            if (k == p)
+            {
+                jp += p;
+                k = 1U;
+            }
+            else
+            {
+                k++;
+            }
+        }
+        else if ((rev == 0U) ? (a > b) : (a < b))
+        {
+            jp += k;
+            k = 1U;
+            p = jp - ip;
+        }
+        else
+        {
+            ip = jp;
+            jp++;
+            k = 1U;
+            p = 1U;
+        }
+    }
+
+    *period = p;
+    return ip + 1U;
+}
+
+/* Factorise needle[0..len) as seen in mode (STRNGR_TW_MIRROR for strngr_twoway_find_last, STRNGR_TW_FOLD for
+ * strngr_twoway_find_nocase) */
+static void strngr_twoway_prepare_dir(strngr_twoway_t *tw, const char *needle, const uint32_t len,
+                                      const uint32_t mode)
+{
+    const uint8_t *n = (const uint8_t *)needle;
+
+    memset((void *)tw->byteset, 0, sizeof(tw->byteset));
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        const uint8_t  b    = strngr_tw_at(n, len, i, mode);
+        const uint32_t dist = len - 1U - i;
+        tw->byteset[b >> 5U] |= (1UL << (b & 31U));
+        tw->shift[b] = (dist > 255U) ? 255U : (uint8_t)dist;
+
+        /* The haystack is not folded, so its upper-case letters look up the same entries */
+        if (((mode & STRNGR_TW_FOLD) != 0U) && ((uint8_t)(b - (uint8_t)'a') < 26U))
+        {
+            const uint8_t u = (uint8_t)(b - 0x20U);
+            tw->byteset[u >> 5U] |= (1UL << (u & 31U));
+            tw->shift[u] = tw->shift[b];
+        }
+    }
+
+    uint32_t p0    = 0U;
+    uint32_t p1    = 0U;
+    uint32_t split = strngr_max_suffix(n, len, 0U, mode, &p0);
+    uint32_t s1    = strngr_max_suffix(n, len, 1U, mode, &p1);
+
+    uint32_t p = p0;
+    if (s1 > split)
+    {
+        split = s1;
+        p     = p1;
+    }
+
+    /* Is the left half a suffix of the first period? Mirrored, both ranges are counted from the end */
+    const uint32_t mirror = mode & STRNGR_TW_MIRROR;
+    const char    *lhs    = (mirror != 0U) ? &needle[len - split] : needle;
+    const char    *rhs    = (mirror != 0U) ? &needle[len - p - split] : &needle[p];
+    const uint32_t diff   = ((mode & STRNGR_TW_FOLD) != 0U) ? (strngr_mismatch_nocase(lhs, rhs, split) != split)
+                                                            : (memcmp((const void *)lhs, (const void *)rhs,
+                                                                      (size_t)split) != 0);
+    if (diff != 0U)
+    {
+        /* Non-periodic: any shift up to the larger half is safe */
+        uint32_t larger = len - split;
+        if ((split - 1U) > larger)
+        {
+            larger = split - 1U;
+        }
+        tw->period = larger + 1U;
+        tw->mem0   = 0U;
+    }
+    else
+    {
+        tw->period = p;
+        tw->mem0   = len - p;
+    }
+
+    tw->split = split;
+}
+
+static void strngr_twoway_prepare(strngr_twoway_t *tw, const char *needle, const uint32_t len)
+{
+    strngr_twoway_prepare_dir(tw, needle, len, 0U);
+}
+
+/* Index of the first occurrence of needle in h[0..hl), or hl if there is none */
+static uint32_t strngr_twoway_find(const strngr_twoway_t *tw, const char *hay, const uint32_t hl, const char *needle,
+                                   const uint32_t nl)
+{
+    const uint8_t *h   = (const uint8_t *)hay;
+    const uint8_t *n   = (const uint8_t *)needle;
+    uint32_t       pos = 0U;
+    uint32_t       mem = 0U;
+
+    while ((hl - pos) >= nl)
+    {
+        const uint8_t *w = &h[pos];
+
+        /* Horspool step on the window's last byte */
+        const uint8_t c = w[nl - 1U];
+        if ((tw->byteset[c >> 5U] & (1UL << (c & 31U))) == 0U)
+        {
+            pos += nl;
+            mem = 0U;
+            continue;
+        }
+        uint32_t k = tw->shift[c];
+        if (k != 0U)
+        {
+            pos += (k < mem) ? mem : k;
+            mem = 0U;
+            continue;
+        }
+
+        /* Right half, skipping anything remembered from the previous period shift */
+        k = (tw->split > mem) ? tw->split : mem;
+        while ((k < nl) && (n[k] == w[k]))
+        {
+            k++;
+        }
+        if (k < nl)
+        {
+            pos += k - tw->split + 1U;
+            mem = 0U;
+            continue;
+        }
+
+        /* Left half */
+        k = tw->split;
+        while ((k > mem) && (n[k - 1U] == w[k - 1U]))
+        {
+            k--;
+        }
+        if (k <= mem)
+        {
+            return pos;
+        }
+
+        pos += tw->period;
+        mem = tw->mem0;
+    }
+
+    return hl;
+}
+
+/* Index of the last occurrence of needle in h[0..hl), or hl if there is none. This is strngr_twoway_find over the
+ * mirrored haystack, with tw prepared from the mirrored needle: w[-k] is the k-th byte back from the window's end. */
+static uint32_t strngr_twoway_find_last(const strngr_twoway_t *tw, const char *hay, const uint32_t hl,
+                                        const char *needle, const uint32_t nl)
+{
+    const uint8_t *h   = (const uint8_t *)hay;
+    const uint8_t *n   = (const uint8_t *)&needle[nl - 1U];
+    uint32_t       pos = 0U;
+    uint32_t       mem = 0U;
+
+    while ((hl - pos) >= nl)
+    {
+        const uint8_t *w = &h[hl - 1U - pos];
+
+        /* Horspool step on the window's first byte */
+        const uint8_t c = *(w - (nl - 1U));
+        if ((tw->byteset[c >> 5U] & (1UL << (c & 31U))) == 0U)
+        {
+            pos += nl;
+            mem = 0U;
+            continue;
+        }
+        uint32_t k = tw->shift[c];
+        if (k != 0U)
+        {
+            pos += (k < mem) ? mem : k;
+            mem = 0U;
+            continue;
+        }
+
+        k = (tw->split > mem) ? tw->split : mem;
+        while ((k < nl) && (*(n - k) == *(w - k)))
+        {
+            k++;
+        }
+        if (k < nl)
+        {
+            pos += k - tw->split + 1U;
+            mem = 0U;
+            continue;
+        }
+
+        k = tw->split;
+        while ((k > mem) && (*(n - (k - 1U)) == *(w - (k - 1U))))
+        {
+            k--;
+        }
+        if (k <= mem)
+        {
+            return hl - pos - nl;
+        }
+
+        pos += tw->period;
+        mem = tw->mem0;
+    }
+
+    return hl;
+}
+
+/* strngr_twoway_find ignoring ASCII case, with tw prepared in STRNGR_TW_FOLD mode */
+static uint32_t strngr_twoway_find_nocase(const strngr_twoway_t *tw, const char *hay, const uint32_t hl,
+                                          const char *needle, const uint32_t nl)
+{
+    const uint8_t *h   = (const uint8_t *)hay;
+    const uint8_t *n   = (const uint8_t *)needle;
+    uint32_t       pos = 0U;
+    uint32_t       mem = 0U;
+
+    while ((hl - pos) >= nl)
+    {
+        const uint8_t *w = &h[pos];
+
+        const uint8_t c = w[nl - 1U];
+        if ((tw->byteset[c >> 5U] & (1UL << (c & 31U))) == 0U)
+        {
+            pos += nl;
+            mem = 0U;
+            continue;
+        }
+        uint32_t k = tw->shift[c];
+        if (k != 0U)
+        {
+            pos += (k < mem) ? mem : k;
+            mem = 0U;
+            continue;
+        }
+
+        k = (tw->split > mem) ? tw->split : mem;
+        while ((k < nl) && (strngr_fold_byte(n[k]) == strngr_fold_byte(w[k])))
+        {
+            k++;
+        }
+        if (k < nl)
+        {
+            pos += k - tw->split + 1U;
+            mem = 0U;
+            continue;
+        }
+
+        k = tw->split;
+        while ((k > mem) && (strngr_fold_byte(n[k - 1U]) == strngr_fold_byte(w[k - 1U])))
+        {
+            k--;
+        }
+        if (k <= mem)
+        {
+            return pos;
+        }
+
+        pos += tw->period;
+        mem = tw->mem0;
+    }
+
+    return hl;
+}
+
+/* Rough byte frequency in text and protocol data; the compiled needle filters on its rarest bytes */
+static const uint8_t strngr_byte_rank[256] = {
+     40U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U, 120U, 200U,  10U,  10U, 110U,  10U,  10U,
+     10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,  10U,
+    255U,  78U, 154U,  76U,  72U,  96U, 100U, 151U, 145U, 142U,  92U,  94U, 172U, 169U, 175U, 163U,
+    160U, 158U, 156U, 154U, 152U, 150U, 148U, 146U, 144U, 142U, 160U, 148U,  86U, 157U,  84U,  98U,
+     74U, 131U,  97U, 113U, 117U, 135U, 105U, 103U, 121U, 127U,  91U,  93U, 115U, 109U, 125U, 129U,
+     99U,  87U, 119U, 123U, 133U, 111U,  95U, 107U,  89U, 101U,  85U,  90U,  68U,  88U,  66U, 166U,
+     62U, 244U, 193U, 217U, 223U, 250U, 205U, 202U, 229U, 238U, 184U, 187U, 220U, 211U, 235U, 241U,
+    196U, 178U, 226U, 232U, 247U, 214U, 190U, 208U, 181U, 199U, 175U,  82U,  70U,  80U,  64U,   5U,
+     20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,
+     20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,
+     20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,
+     20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,
+     20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,
+     20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,
+     20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,
+     20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,  20U,
+};
+
+/* Two-Way search of the remainder once the candidate filter has blown its verification budget */
+static uint32_t strngr_find_long(const strngr_twoway_t *tw, const char *h, const uint32_t hl, const char *n,
+                                 const uint32_t nl)
+{
+    if (tw != NULL)
+    {
+        return strngr_twoway_find(tw, h, hl, n, nl);
+    }
+
+    strngr_twoway_t local;
+    strngr_twoway_prepare(&local, n, nl);
+    return strngr_twoway_find(&local, h, hl, n, nl);
+}
+
+/* Candidate filter on the needle bytes at offsets o1 and o2, verified with memcmp (2 <= nl <= hl).
+ * tw is the needle's prepared Two-Way state, or NULL to prepare it only if the filter gives up. */
+static uint32_t strngr_find_pair(const char *h, const uint32_t hl, const char *n, const uint32_t nl, const uint32_t o1,
+                                 const uint32_t o2, const strngr_twoway_t *tw)
+{
+    const uint32_t last     = hl - nl;
+    uint32_t       i        = 0U;
+    uint64_t       verified = 0U;
+
+#if defined(STRNGR_AVX2)
+    const __m256i b1_32 = _mm256_set1_epi8(n[o1]);
+    const __m256i b2_32 = _mm256_set1_epi8(n[o2]);
+    while ((last - i) >= 32U)
+    {
+        const __m256i a = _mm256_loadu_si256((const __m256i *)&h[i + o1]);
+        const __m256i b = _mm256_loadu_si256((const __m256i *)&h[i + o2]);
+        uint32_t m = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, b1_32),
+                                                                     _mm256_cmpeq_epi8(b, b2_32)));
+        while (m != 0U)
+        {
+            const uint32_t at = i + strngr_ctz32(m);
+            if (memcmp((const void *)&h[at], (const void *)n, (size_t)nl) == 0)
+            {
+                return at;
+            }
+            verified += nl;
+            m &= m - 1U;
+        }
+
+        i += 32U;
+        if (verified > (((uint64_t)i * STRNGR_VERIFY_BUDGET) + 1024U))
+        {
+            return i + strngr_find_long(tw, &h[i], hl - i, n, nl);
+        }
+    }
+#endif
+
+#if defined(STRNGR_SSE2)
+    const __m128i b1_16 = _mm_set1_epi8(n[o1]);
+    const __m128i b2_16 = _mm_set1_epi8(n[o2]);
+    while ((last - i) >= 16U)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i *)&h[i + o1]);
+        const __m128i b = _mm_loadu_si128((const __m128i *)&h[i + o2]);
+        uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, b1_16), _mm_cmpeq_epi8(b, b2_16)));
+        while (m != 0U)
+        {
+            const uint32_t at = i + strngr_ctz32(m);
+            if (memcmp((const void *)&h[at], (const void *)n, (size_t)nl) == 0)
+            {
+                return at;
+            }
+            verified += nl;
+            m &= m - 1U;
+        }
+
+        i += 16U;
+        if (verified > (((uint64_t)i * STRNGR_VERIFY_BUDGET) + 1024U))
+        {
+            return i + strngr_find_long(tw, &h[i], hl - i, n, nl);
+        }
+    }
+#else
+    /* memchr-style: jump between occurrences of the byte at o1 */
+    while (i <= last)
+    {
+        const uint32_t at = i + strngr_find_byte(&h[i + o1], last - i + 1U, n[o1]);
+        if (at > last)
+        {
+            return hl;
+        }
+        if ((h[at + o2] == n[o2]) && (memcmp((const void *)&h[at], (const void *)n, (size_t)nl) == 0))
+        {
+            return at;
+        }
+
+        verified += nl;
+        i = at + 1U;
+        if (verified > (((uint64_t)i * STRNGR_VERIFY_BUDGET) + 1024U))
+        {
+            return i + strngr_find_long(tw, &h[i], hl - i, n, nl);
+        }
+    }
+#endif
+
+    for (; i <= last; i++)
+    {
+        if ((h[i + o1] == n[o1]) && (h[i + o2] == n[o2]) &&
+            (memcmp((const void *)&h[i], (const void *)n, (size_t)nl) == 0))
+        {
+            return i;
+        }
+    }
+
+    return hl;
+}
+
+/* Index of the first occurrence of n[0..nl) in h[0..hl), or hl if there is none (nl >= 1) */
+static uint32_t strngr_find_sub(const char *h, const uint32_t hl, const char *n, const uint32_t nl)
+{
+    if (nl > hl)
+    {
+        return hl;
+    }
+
+    if (nl == 1U)
+    {
+        return strngr_find_byte(h, hl, n[0]);
+    }
+
+    if (nl <= STRNGR_SHORT_NEEDLE_MAX)
+    {
+        return strngr_find_pair(h, hl, n, nl, 0U, nl - 1U, NULL);
+    }
+
+    return strngr_find_long(NULL, h, hl, n, nl);
+}
+
+/* Backward Two-Way search of what is left once the reverse candidate filter has blown its verification budget */
+static uint32_t strngr_find_long_last(const char *h, const uint32_t hl, const char *n, const uint32_t nl)
+{
+    strngr_twoway_t local;
+    strngr_twoway_prepare_dir(&local, n, nl, STRNGR_TW_MIRROR);
+    return strngr_twoway_find_last(&local, h, hl, n, nl);
+}
+
+/* strngr_find_pair run from the end of the haystack: index of the last occurrence of n (2 <= nl <= hl), or hl */
+static uint32_t strngr_find_pair_last(const char *h, const uint32_t hl, const char *n, const uint32_t nl,
+                                      const uint32_t o1, const uint32_t o2)
+{
+    const uint32_t count    = hl - nl + 1U;
+    uint32_t       i        = count;
+    uint64_t       verified = 0U;
+
+    /* Candidates left to try are [0, i); the budget falls back to Two-Way on the prefix that holds them */
+#if defined(STRNGR_AVX2)
+    const __m256i b1_32 = _mm256_set1_epi8(n[o1]);
+    const __m256i b2_32 = _mm256_set1_epi8(n[o2]);
+    while (i >= 32U)
+    {
+        const uint32_t base = i - 32U;
+        const __m256i  a    = _mm256_loadu_si256((const __m256i *)&h[base + o1]);
+        const __m256i  b    = _mm256_loadu_si256((const __m256i *)&h[base + o2]);
+        uint32_t m = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, b1_32),
+                                                                     _mm256_cmpeq_epi8(b, b2_32)));
+        while (m != 0U)
+        {
+            const uint32_t top = strngr_msb32(m);
+            if (memcmp((const void *)&h[base + top], (const void *)n, (size_t)nl) == 0)
+            {
+                return base + top;
+            }
+            verified += nl;
+            m &= ~(1UL << top);
+        }
+
+        i = base;
+        if (verified > (((uint64_t)(count - i) * STRNGR_VERIFY_BUDGET) + 1024U))
+        {
+            const uint32_t at = strngr_find_long_last(h, (i + nl) - 1U, n, nl);
+            return (at < i) ? at : hl;
+        }
+    }
+#endif
+
+#if defined(STRNGR_SSE2)
+    const __m128i b1_16 = _mm_set1_epi8(n[o1]);
+    const __m128i b2_16 = _mm_set1_epi8(n[o2]);
+    while (i >= 16U)
+    {
+        const uint32_t base = i - 16U;
+        const __m128i  a    = _mm_loadu_si128((const __m128i *)&h[base + o1]);
+        const __m128i  b    = _mm_loadu_si128((const __m128i *)&h[base + o2]);
+        uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, b1_16), _mm_cmpeq_epi8(b, b2_16)));
+        while (m != 0U)
+        {
+            const uint32_t top = strngr_msb32(m);
+            if (memcmp((const void *)&h[base + top], (const void *)n, (size_t)nl) == 0)
+            {
+                return base + top;
+            }
+            verified += nl;
+            m &= ~(1UL << top);
+        }
+
+        i = base;
+        if (verified > (((uint64_t)(count - i) * STRNGR_VERIFY_BUDGET) + 1024U))
+        {
+            const uint32_t at = strngr_find_long_last(h, (i + nl) - 1U, n, nl);
+            return (at < i) ? at : hl;
+        }
+    }
+#else
+    /* memrchr-style: jump back between occurrences of the byte at o1 */
+    while (i > 0U)
+    {
+        const uint32_t at = strngr_find_byte_last(&h[o1], i, n[o1]);
+        if (at >= i)
+        {
+            return hl;
+        }
+        if ((h[at + o2] == n[o2]) && (memcmp((const void *)&h[at], (const void *)n, (size_t)nl) == 0))
+        {
+            return at;
+        }
+
+        verified += nl;
+        i = at;
+        if (verified > (((uint64_t)(count - i) * STRNGR_VERIFY_BUDGET) + 1024U))
+        {
+            const uint32_t last = strngr_find_long_last(h, (i + nl) - 1U, n, nl);
+            return (last < i) ? last : hl;
+        }
+    }
+#endif
+
+    for (; i > 0U; i--)
+    {
+        const uint32_t at = i - 1U;
+        if ((h[at + o1] == n[o1]) && (h[at + o2] == n[o2]) &&
+            (memcmp((const void *)&h[at], (const void *)n, (size_t)nl) == 0))
+        {
+            return at;
+        }
+    }
+
+    return hl;
+}
+
+/* Index of the last occurrence of n[0..nl) in h[0..hl), or hl if there is none (nl >= 1) */
+static uint32_t strngr_find_sub_last(const char *h, const uint32_t hl, const char *n, const uint32_t nl)
+{
+    if (nl > hl)
+    {
+        return hl;
+    }
+
+    if (nl == 1U)
+    {
+        return strngr_find_byte_last(h, hl, n[0]);
+    }
+
+    if (nl <= STRNGR_SHORT_NEEDLE_MAX)
+    {
+        return strngr_find_pair_last(h, hl, n, nl, 0U, nl - 1U);
+    }
+
+    return strngr_find_long_last(h, hl, n, nl);
+}
+
+/* strngr_find_pair ignoring ASCII case, on the first and last needle bytes (1 <= nl <= hl). Haystack blocks are
+ * folded in registers; past the verification budget the rest is searched with case-folded Two-Way. */
+static uint32_t strngr_find_sub_nocase(const char *h, const uint32_t hl, const char *n, const uint32_t nl)
+{
+    const uint32_t last     = hl - nl;
+    const uint8_t  f1       = strngr_fold_byte((uint8_t)n[0]);
+    const uint8_t  f2       = strngr_fold_byte((uint8_t)n[nl - 1U]);
+    uint32_t       i        = 0U;
+    uint64_t       verified = 0U;
+
+#if defined(STRNGR_AVX2)
+    const __m256i b1_32 = _mm256_set1_epi8((char)f1);
+    const __m256i b2_32 = _mm256_set1_epi8((char)f2);
+    while ((last - i) >= 32U)
+    {
+        const __m256i a = strngr_fold256(_mm256_loadu_si256((const __m256i *)&h[i]));
+        const __m256i b = strngr_fold256(_mm256_loadu_si256((const __m256i *)&h[i + nl - 1U]));
+        uint32_t m = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, b1_32),
+                                                                     _mm256_cmpeq_epi8(b, b2_32)));
+        while (m != 0U)
+        {
+            const uint32_t at = i + strngr_ctz32(m);
+            if (strngr_mismatch_nocase(&h[at], n, nl) == nl)
+            {
+                return at;
+            }
+            verified += nl;
+            m &= m - 1U;
+        }
+
+        i += 32U;
+        if (verified > (((uint64_t)i * STRNGR_VERIFY_BUDGET) + 1024U))
+        {
+            break;
+        }
+    }
+#endif
+
+#if defined(STRNGR_SSE2)
+    const __m128i b1_16 = _mm_set1_epi8((char)f1);
+    const __m128i b2_16 = _mm_set1_epi8((char)f2);
+    while (((last - i) >= 16U) && (verified <= (((uint64_t)i * STRNGR_VERIFY_BUDGET) + 1024U)))
+    {
+        const __m128i a = strngr_fold128(_mm_loadu_si128((const __m128i *)&h[i]));
+        const __m128i b = strngr_fold128(_mm_loadu_si128((const __m128i *)&h[i + nl - 1U]));
+        uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, b1_16), _mm_cmpeq_epi8(b, b2_16)));
+        while (m != 0U)
+        {
+            const uint32_t at = i + strngr_ctz32(m);
+            if (strngr_mismatch_nocase(&h[at], n, nl) == nl)
+            {
+                return at;
+            }
+            verified += nl;
+            m &= m - 1U;
+        }
+
+        i += 16U;
+    }
+#endif
+
+    for (; (i <= last) && (verified <= (((uint64_t)i * STRNGR_VERIFY_BUDGET) + 1024U)); i++)
+    {
+        if ((strngr_fold_byte((uint8_t)h[i]) == f1) && (strngr_fold_byte((uint8_t)h[i + nl - 1U]) == f2))
+        {
+            if (strngr_mismatch_nocase(&h[i], n, nl) == nl)
+            {
+                return i;
+            }
+            verified += nl;
+        }
+    }
+
+    if (i > last)
+    {
+        return hl;
+    }
+
+    strngr_twoway_t tw;
+    strngr_twoway_prepare_dir(&tw, n, nl, STRNGR_TW_FOLD);
+    return i + strngr_twoway_find_nocase(&tw, &h[i], hl - i, n, nl);
+}
+
+#define STRNGR_SET_HAS(set, b) ((((set)[(uint8_t)(b) >> 5U]) >> ((uint8_t)(b) & 31U)) & 1U)
+
+/* Index of the first byte of s[i..len) whose membership in set is want (1: a member, 0: not a member), or len */
+static uint32_t strngr_find_class_tail(const char *s, uint32_t i, const uint32_t len, const strngr_byteset_t *set,
+                                       const uint32_t want)
+{
+    for (; i < len; i++)
+    {
+        if (STRNGR_SET_HAS(set->bits, s[i]) == want)
+        {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+#if defined(STRNGR_SSSE3)
+/* Nibble classification: lo[b & 15] & hi[b >> 4] is non-zero exactly for members, two shuffles per vector */
+static uint32_t strngr_find_class_nibble(const char *s, const uint32_t len, const strngr_byteset_t *set,
+                                         const uint32_t want)
+{
+    uint32_t      i     = 0U;
+    const __m128i lo128 = _mm_loadu_si128((const __m128i *)set->lo);
+    const __m128i hi128 = _mm_loadu_si128((const __m128i *)set->hi);
+
+#if defined(STRNGR_AVX512)
+    const __m512i lo512  = _mm512_broadcast_i32x4(lo128);
+    const __m512i hi512  = _mm512_broadcast_i32x4(hi128);
+    const __m512i nib512 = _mm512_set1_epi8(0x0F);
+    for (; (len - i) >= 64U; i += 64U)
+    {
+        const __m512i c   = _mm512_loadu_si512((const void *)&s[i]);
+        const __m512i cls = _mm512_and_si512(_mm512_shuffle_epi8(lo512, _mm512_and_si512(c, nib512)),
+                                             _mm512_shuffle_epi8(hi512, _mm512_and_si512(_mm512_srli_epi16(c, 4), nib512)));
+        uint64_t m = _mm512_test_epi8_mask(cls, cls);
+        if (want == 0U)
+        {
+            m = ~m;
+        }
+        if (m != 0U)
+        {
+            return i + strngr_ctz64(m);
+        }
+    }
+#endif
+
+#if defined(STRNGR_AVX2)
+    const __m256i lo256  = _mm256_broadcastsi128_si256(lo128);
+    const __m256i hi256  = _mm256_broadcastsi128_si256(hi128);
+    const __m256i nib256 = _mm256_set1_epi8(0x0F);
+    const uint32_t flip32 = (want == 0U) ? 0U : 0xFFFFFFFFUL;
+    for (; (len - i) >= 32U; i += 32U)
+    {
+        const __m256i c   = _mm256_loadu_si256((const __m256i *)&s[i]);
+        const __m256i cls = _mm256_and_si256(_mm256_shuffle_epi8(lo256, _mm256_and_si256(c, nib256)),
+                                             _mm256_shuffle_epi8(hi256, _mm256_and_si256(_mm256_srli_epi16(c, 4), nib256)));
+        const uint32_t m =
+            flip32 ^ (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(cls, _mm256_setzero_si256()));
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+#endif
+
+    const __m128i  nib128 = _mm_set1_epi8(0x0F);
+    const uint32_t flip16 = (want == 0U) ? 0U : 0xFFFFU;
+    for (; (len - i) >= 16U; i += 16U)
+    {
+        const __m128i c   = _mm_loadu_si128((const __m128i *)&s[i]);
+        const __m128i cls = _mm_and_si128(_mm_shuffle_epi8(lo128, _mm_and_si128(c, nib128)),
+                                          _mm_shuffle_epi8(hi128, _mm_and_si128(_mm_srli_epi16(c, 4), nib128)));
+        const uint32_t m = flip16 ^ (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(cls, _mm_setzero_si128()));
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+
+    return strngr_find_class_tail(s, i, len, set, want);
+}
+#endif
+
+/* Sets of at most four members compared directly against any[] (padded by repetition) */
+static uint32_t strngr_find_class_any(const char *s, const uint32_t len, const strngr_byteset_t *set,
+                                      const uint32_t want)
+{
+    const uint8_t *any = set->any;
+    uint32_t       i   = 0U;
+
+#if defined(STRNGR_AVX2)
+    const __m256i  a0     = _mm256_set1_epi8((char)any[0]);
+    const __m256i  a1     = _mm256_set1_epi8((char)any[1]);
+    const __m256i  a2     = _mm256_set1_epi8((char)any[2]);
+    const __m256i  a3     = _mm256_set1_epi8((char)any[3]);
+    const uint32_t flip32 = (want == 0U) ? 0xFFFFFFFFUL : 0U;
+    for (; (len - i) >= 32U; i += 32U)
+    {
+        const __m256i c  = _mm256_loadu_si256((const __m256i *)&s[i]);
+        const __m256i eq = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(c, a0), _mm256_cmpeq_epi8(c, a1)),
+                                           _mm256_or_si256(_mm256_cmpeq_epi8(c, a2), _mm256_cmpeq_epi8(c, a3)));
+        const uint32_t m = flip32 ^ (uint32_t)_mm256_movemask_epi8(eq);
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+#endif
+
+#if defined(STRNGR_SSE2)
+    const __m128i  b0     = _mm_set1_epi8((char)any[0]);
+    const __m128i  b1     = _mm_set1_epi8((char)any[1]);
+    const __m128i  b2     = _mm_set1_epi8((char)any[2]);
+    const __m128i  b3     = _mm_set1_epi8((char)any[3]);
+    const uint32_t flip16 = (want == 0U) ? 0xFFFFU : 0U;
+    for (; (len - i) >= 16U; i += 16U)
+    {
+        const __m128i c  = _mm_loadu_si128((const __m128i *)&s[i]);
+        const __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, b0), _mm_cmpeq_epi8(c, b1)),
+                                        _mm_or_si128(_mm_cmpeq_epi8(c, b2), _mm_cmpeq_epi8(c, b3)));
+        const uint32_t m = flip16 ^ (uint32_t)_mm_movemask_epi8(eq);
+        if (m != 0U)
+        {
+            return i + strngr_ctz32(m);
+        }
+    }
+#else
+    /* Word-at-a-time, for finding members only: skip words with no byte equal to any of the four */
+    const uint64_t p0 = STRNGR_SWAR_ONES * (uint64_t)any[0];
+    const uint64_t p1 = STRNGR_SWAR_ONES * (uint64_t)any[1];
+    const uint64_t p2 = STRNGR_SWAR_ONES * (uint64_t)any[2];
+    const uint64_t p3 = STRNGR_SWAR_ONES * (uint64_t)any[3];
+    for (; (want != 0U) && ((len - i) >= 8U); i += 8U)
+    {
+        const uint64_t w = strngr_load64(&s[i]);
+        if ((strngr_swar_has_zero(w ^ p0) | strngr_swar_has_zero(w ^ p1) | strngr_swar_has_zero(w ^ p2) |
+             strngr_swar_has_zero(w ^ p3)) != 0U)
+        {
+            break;
+        }
+    }
+#endif
+
+    return strngr_find_class_tail(s, i, len, set, want);
+}
+
+/* Index of the first byte of s[0..len) that is in set (want 1) or not in set (want 0), or len if there is none */
+static uint32_t strngr_find_class(const char *s, const uint32_t len, const strngr_byteset_t *set, const uint32_t want)
+{
+#if defined(STRNGR_SSSE3)
+    if (set->nibble != 0U)
+    {
+        return strngr_find_class_nibble(s, len, set, want);
+    }
+#endif
+
+    if (set->count <= 4U)
+    {
+        return strngr_find_class_any(s, len, set, want);
+    }
+
+    return strngr_find_class_tail(s, 0U, len, set, want);
+}
+
+/* Index of the last byte of s[0..len) whose membership in set is want, or len if there is none */
+static uint32_t strngr_find_class_last(const char *s, const uint32_t len, const strngr_byteset_t *set,
+                                       const uint32_t want)
+{
+    uint32_t end = len;
+
+#if defined(STRNGR_SSSE3)
+    if (set->nibble != 0U)
+    {
+        const __m128i lo128 = _mm_loadu_si128((const __m128i *)set->lo);
+        const __m128i hi128 = _mm_loadu_si128((const __m128i *)set->hi);
+
+#if defined(STRNGR_AVX2)
+        const __m256i  lo256  = _mm256_broadcastsi128_si256(lo128);
+        const __m256i  hi256  = _mm256_broadcastsi128_si256(hi128);
+        const __m256i  nib256 = _mm256_set1_epi8(0x0F);
+        const uint32_t flip32 = (want == 0U) ? 0U : 0xFFFFFFFFUL;
+        for (; end >= 32U; end -= 32U)
+        {
+            const __m256i c   = _mm256_loadu_si256((const __m256i *)&s[end - 32U]);
+            const __m256i cls = _mm256_and_si256(_mm256_shuffle_epi8(lo256, _mm256_and_si256(c, nib256)),
+                                                 _mm256_shuffle_epi8(hi256, _mm256_and_si256(_mm256_srli_epi16(c, 4), nib256)));
+            const uint32_t m =
+                flip32 ^ (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(cls, _mm256_setzero_si256()));
+            if (m != 0U)
+            {
+                return end - 32U + strngr_msb32(m);
+            }
+        }
+#endif
+
+        const __m128i  nib128 = _mm_set1_epi8(0x0F);
+        const uint32_t flip16 = (want == 0U) ? 0U : 0xFFFFU;
+        for (; end >= 16U; end -= 16U)
+        {
+            const __m128i c   = _mm_loadu_si128((const __m128i *)&s[end - 16U]);
+            const __m128i cls = _mm_and_si128(_mm_shuffle_epi8(lo128, _mm_and_si128(c, nib128)),
+                                              _mm_shuffle_epi8(hi128, _mm_and_si128(_mm_srli_epi16(c, 4), nib128)));
+            const uint32_t m = flip16 ^ (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(cls, _mm_setzero_si128()));
+            if (m != 0U)
+            {
+                return end - 16U + strngr_msb32(m);
+            }
+        }
+    }
+#endif
+
+    while (end > 0U)
+    {
+        end--;
+        if (STRNGR_SET_HAS(set->bits, s[end]) == want)
+        {
+            return end;
+        }
+    }
+
+    return len;
+}
+
+/* strngr_byteset_compile of "\t\n\v\f\r ": rows 0x0_ (bucket 0, \t to \r) and 0x2_ (bucket 1, space) */
+static const strngr_byteset_t strngr_ws_set = {
+    {0x00003E00UL, 0x00000001UL, 0U, 0U, 0U, 0U, 0U, 0U},
+    {2U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U, 1U, 1U, 1U, 1U, 0U, 0U},
+    {1U, 0U, 2U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U},
+    {(uint8_t)'\t', (uint8_t)'\n', (uint8_t)'\v', (uint8_t)'\f'},
+    6U,
+    1U,
+};
+
+#if defined(STRNGR_SSSE3)
+/* Byte k of entry m is the index of the k-th set bit of m: a pshufb control that packs the kept bytes of an
+ * 8-byte lane to its front */
+static const uint64_t strngr_compress8[256] = {
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000100ULL,
+    0x0000000000000002ULL, 0x0000000000000200ULL, 0x0000000000000201ULL, 0x0000000000020100ULL,
+    0x0000000000000003ULL, 0x0000000000000300ULL, 0x0000000000000301ULL, 0x0000000000030100ULL,
+    0x0000000000000302ULL, 0x0000000000030200ULL, 0x0000000000030201ULL, 0x0000000003020100ULL,
+    0x0000000000000004ULL, 0x0000000000000400ULL, 0x0000000000000401ULL, 0x0000000000040100ULL,
+    0x0000000000000402ULL, 0x0000000000040200ULL, 0x0000000000040201ULL, 0x0000000004020100ULL,
+    0x0000000000000403ULL, 0x0000000000040300ULL, 0x0000000000040301ULL, 0x0000000004030100ULL,
+    0x0000000000040302ULL, 0x0000000004030200ULL, 0x0000000004030201ULL, 0x0000000403020100ULL,
+    0x0000000000000005ULL, 0x0000000000000500ULL, 0x0000000000000501ULL, 0x0000000000050100ULL,
+    0x0000000000000502ULL, 0x0000000000050200ULL, 0x0000000000050201ULL, 0x0000000005020100ULL,
+    0x0000000000000503ULL, 0x0000000000050300ULL, 0x0000000000050301ULL, 0x0000000005030100ULL,
+    0x0000000000050302ULL, 0x0000000005030200ULL, 0x0000000005030201ULL, 0x0000000503020100ULL,
+    0x0000000000000504ULL, 0x0000000000050400ULL, 0x0000000000050401ULL, 0x0000000005040100ULL,
+    0x0000000000050402ULL, 0x0000000005040200ULL, 0x0000000005040201ULL, 0x0000000504020100ULL,
+    0x0000000000050403ULL, 0x0000000005040300ULL, 0x0000000005040301ULL, 0x0000000504030100ULL,
+    0x0000000005040302ULL, 0x0000000504030200ULL, 0x0000000504030201ULL, 0x0000050403020100ULL,
+    0x0000000000000006ULL, 0x0000000000000600ULL, 0x0000000000000601ULL, 0x0000000000060100ULL,
+    0x0000000000000602ULL, 0x0000000000060200ULL, 0x0000000000060201ULL, 0x0000000006020100ULL,
+    0x0000000000000603ULL, 0x0000000000060300ULL, 0x0000000000060301ULL, 0x0000000006030100ULL,
+    0x0000000000060302ULL, 0x0000000006030200ULL, 0x0000000006030201ULL, 0x0000000603020100ULL,
+    0x0000000000000604ULL, 0x0000000000060400ULL, 0x0000000000060401ULL, 0x0000000006040100ULL,
+    0x0000000000060402ULL, 0x0000000006040200ULL, 0x0000000006040201ULL, 0x0000000604020100ULL,
+    0x0000000000060403ULL, 0x0000000006040300ULL, 0x0000000006040301ULL, 0x0000000604030100ULL,
+    0x0000000006040302ULL, 0x0000000604030200ULL, 0x0000000604030201ULL, 0x0000060403020100ULL,
+    0x0000000000000605ULL, 0x0000000000060500ULL, 0x0000000000060501ULL, 0x0000000006050100ULL,
+    0x0000000000060502ULL, 0x0000000006050200ULL, 0x0000000006050201ULL, 0x0000000605020100ULL,
+    0x0000000000060503ULL, 0x0000000006050300ULL, 0x0000000006050301ULL, 0x0000000605030100ULL,
+    0x0000000006050302ULL, 0x0000000605030200ULL, 0x0000000605030201ULL, 0x0000060503020100ULL,
+    0x0000000000060504ULL, 0x0000000006050400ULL, 0x0000000006050401ULL, 0x0000000605040100ULL,
+    0x0000000006050402ULL, 0x0000000605040200ULL, 0x0000000605040201ULL, 0x0000060504020100ULL,
+    0x0000000006050403ULL, 0x0000000605040300ULL, 0x0000000605040301ULL, 0x0000060504030100ULL,
+    0x0000000605040302ULL, 0x0000060504030200ULL, 0x0000060504030201ULL, 0x0006050403020100ULL,
+    0x0000000000000007ULL, 0x0000000000000700ULL, 0x0000000000000701ULL, 0x0000000000070100ULL,
+    0x0000000000000702ULL, 0x0000000000070200ULL, 0x0000000000070201ULL, 0x0000000007020100ULL,
+    0x0000000000000703ULL, 0x0000000000070300ULL, 0x0000000000070301ULL, 0x0000000007030100ULL,
+    0x0000000000070302ULL, 0x0000000007030200ULL, 0x0000000007030201ULL, 0x0000000703020100ULL,
+    0x0000000000000704ULL, 0x0000000000070400ULL, 0x0000000000070401ULL, 0x0000000007040100ULL,
+    0x0000000000070402ULL, 0x0000000007040200ULL, 0x0000000007040201ULL, 0x0000000704020100ULL,
+    0x0000000000070403ULL, 0x0000000007040300ULL, 0x0000000007040301ULL, 0x0000000704030100ULL,
+    0x0000000007040302ULL, 0x0000000704030200ULL, 0x0000000704030201ULL, 0x0000070403020100ULL,
+    0x0000000000000705ULL, 0x0000000000070500ULL, 0x0000000000070501ULL, 0x0000000007050100ULL,
+    0x0000000000070502ULL, 0x0000000007050200ULL, 0x0000000007050201ULL, 0x0000000705020100ULL,
+    0x0000000000070503ULL, 0x0000000007050300ULL, 0x0000000007050301ULL, 0x0000000705030100ULL,
+    0x0000000007050302ULL, 0x0000000705030200ULL, 0x0000000705030201ULL, 0x0000070503020100ULL,
+    0x0000000000070504ULL, 0x0000000007050400ULL, 0x0000000007050401ULL, 0x0000000705040100ULL,
+    0x0000000007050402ULL, 0x0000000705040200ULL, 0x0000000705040201ULL, 0x0000070504020100ULL,
+    0x0000000007050403ULL, 0x0000000705040300ULL, 0x0000000705040301ULL, 0x0000070504030100ULL,
+    0x0000000705040302ULL, 0x0000070504030200ULL, 0x0000070504030201ULL, 0x0007050403020100ULL,
+    0x0000000000000706ULL, 0x0000000000070600ULL, 0x0000000000070601ULL, 0x0000000007060100ULL,
+    0x0000000000070602ULL, 0x0000000007060200ULL, 0x0000000007060201ULL, 0x0000000706020100ULL,
+    0x0000000000070603ULL, 0x0000000007060300ULL, 0x0000000007060301ULL, 0x0000000706030100ULL,
+    0x0000000007060302ULL, 0x0000000706030200ULL, 0x0000000706030201ULL, 0x0000070603020100ULL,
+    0x0000000000070604ULL, 0x0000000007060400ULL, 0x0000000007060401ULL, 0x0000000706040100ULL,
+    0x0000000007060402ULL, 0x0000000706040200ULL, 0x0000000706040201ULL, 0x0000070604020100ULL,
+    0x0000000007060403ULL, 0x0000000706040300ULL, 0x0000000706040301ULL, 0x0000070604030100ULL,
+    0x0000000706040302ULL, 0x0000070604030200ULL, 0x0000070604030201ULL, 0x0007060403020100ULL,
+    0x0000000000070605ULL, 0x0000000007060500ULL, 0x0000000007060501ULL, 0x0000000706050100ULL,
+    0x0000000007060502ULL, 0x0000000706050200ULL, 0x0000000706050201ULL, 0x0000070605020100ULL,
+    0x0000000007060503ULL, 0x0000000706050300ULL, 0x0000000706050301ULL, 0x0000070605030100ULL,
+    0x0000000706050302ULL, 0x0000070605030200ULL, 0x0000070605030201ULL, 0x0007060503020100ULL,
+    0x0000000007060504ULL, 0x0000000706050400ULL, 0x0000000706050401ULL, 0x0000070605040100ULL,
+    0x0000000706050402ULL, 0x0000070605040200ULL, 0x0000070605040201ULL, 0x0007060504020100ULL,
+    0x0000000706050403ULL, 0x0000070605040300ULL, 0x0000070605040301ULL, 0x0007060504030100ULL,
+    0x0000070605040302ULL, 0x0007060504030200ULL, 0x0007060504030201ULL, 0x0706050403020100ULL,
+};
+#endif
+
+/* Rewrite each run of set members in s[0..len) to one ' ', in place; returns the new length */
+static uint32_t strngr_collapse_bytes(char *s, const uint32_t len, const strngr_byteset_t *set)
+{
+    uint32_t i    = 0U;
+    uint32_t w    = 0U;
+    uint32_t prev = 0U; /* s[i - 1] was a member */
+
+#if defined(STRNGR_SSSE3)
+    if (set->nibble != 0U)
+    {
+        /* Members become ' ', and a member right after another member is dropped. Output never overtakes input,
+         * so each store lands on bytes this or an earlier block has already loaded. */
+        const __m128i lo128 = _mm_loadu_si128((const __m128i *)set->lo);
+        const __m128i hi128 = _mm_loadu_si128((const __m128i *)set->hi);
+
+#if defined(STRNGR_AVX512_VBMI2)
+        const __m512i lo512  = _mm512_broadcast_i32x4(lo128);
+        const __m512i hi512  = _mm512_broadcast_i32x4(hi128);
+        const __m512i nib512 = _mm512_set1_epi8(0x0F);
+        for (; (len - i) >= 64U; i += 64U)
+        {
+            const __m512i  c    = _mm512_loadu_si512((const void *)&s[i]);
+            const __m512i  cls  = _mm512_and_si512(_mm512_shuffle_epi8(lo512, _mm512_and_si512(c, nib512)),
+                                                   _mm512_shuffle_epi8(hi512, _mm512_and_si512(_mm512_srli_epi16(c, 4), nib512)));
+            const uint64_t m    = _mm512_test_epi8_mask(cls, cls);
+            const uint64_t keep = ~(m & ((m << 1U) | prev));
+            _mm512_mask_compressstoreu_epi8((void *)&s[w], keep, _mm512_mask_blend_epi8(m, c, _mm512_set1_epi8(' ')));
+            w += strngr_popcount64(keep);
+            prev = (uint32_t)(m >> 63U);
+        }
+#endif
+
+        const __m128i nib128 = _mm_set1_epi8(0x0F);
+        for (; (len - i) >= 16U; i += 16U)
+        {
+            const __m128i c   = _mm_loadu_si128((const __m128i *)&s[i]);
+            const __m128i cls = _mm_and_si128(_mm_shuffle_epi8(lo128, _mm_and_si128(c, nib128)),
+                                              _mm_shuffle_epi8(hi128, _mm_and_si128(_mm_srli_epi16(c, 4), nib128)));
+            const __m128i  non = _mm_cmpeq_epi8(cls, _mm_setzero_si128());
+            const uint32_t m   = 0xFFFFU ^ (uint32_t)_mm_movemask_epi8(non);
+            if (m == 0U)
+            {
+                _mm_storeu_si128((__m128i *)&s[w], c);
+                w += 16U;
+                prev = 0U;
+                continue;
+            }
+
+            const uint32_t keep = 0xFFFFU & ~(m & ((m << 1U) | prev));
+            const __m128i  v    = _mm_or_si128(_mm_and_si128(non, c), _mm_andnot_si128(non, _mm_set1_epi8(' ')));
+            const __m128i  ctl0 = _mm_loadl_epi64((const __m128i *)&strngr_compress8[keep & 0xFFU]);
+            const __m128i  ctl1 = _mm_add_epi8(_mm_loadl_epi64((const __m128i *)&strngr_compress8[keep >> 8U]),
+                                               _mm_set1_epi8(8));
+            _mm_storel_epi64((__m128i *)&s[w], _mm_shuffle_epi8(v, ctl0));
+            w += strngr_popcount64(keep & 0xFFU);
+            _mm_storel_epi64((__m128i *)&s[w], _mm_shuffle_epi8(v, ctl1));
+            w += strngr_popcount64(keep >> 8U);
+            prev = m >> 15U;
+        }
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        const uint32_t member = STRNGR_SET_HAS(set->bits, s[i]);
+        if (member == 0U)
+        {
+            s[w] = s[i];
+            w++;
+        }
+        else if (prev == 0U)
+        {
+            s[w] = ' ';
+            w++;
+        }
+        prev = member;
+    }
+
+    return w;
+}
+
+/* Index of the first occurrence of a compiled, non-empty needle in h[0..hl), or hl if there is none */
+static uint32_t strngr_needle_find(const strngr_needle_t *needle, const char *h, const uint32_t hl)
+{
+    const str_t n = needle->pattern;
+
+    if (hl < n.len)
+    {
+        return hl;
+    }
+
+    if (n.len == 1U)
+    {
+        return strngr_find_byte(h, hl, n.str[0]);
+    }
+
+    return strngr_find_pair(h, hl, n.str, n.len, needle->rare1, needle->rare2, &needle->tw);
+}
+
+/* Index of the next occurrence of a compiled needle after the one at h[at], or hl if there is none. Occurrences are
+ * at least the Two-Way period apart, and a periodic needle's window one period on already matches all but its last
+ * period bytes, so a run of overlapping matches costs O(n) rather than a full verification each. */
+static uint32_t strngr_needle_find_next(const strngr_needle_t *needle, const char *h, const uint32_t hl,
+                                        const uint32_t at)
+{
+    const str_t n    = needle->pattern;
+    uint32_t    next = at + 1U;
+
+    if (n.len >= 2U)
+    {
+        const uint32_t p = needle->tw.period;
+        next             = at + p;
+        if (needle->tw.mem0 != 0U)
+        {
+            if ((hl - next) < n.len)
+            {
+                return hl;
+            }
+            if (memcmp((const void *)&h[at + n.len], (const void *)&n.str[n.len - p], (size_t)p) == 0)
+            {
+                return next;
+            }
+            next++;
+        }
+    }
+
+    if ((hl - next) < n.len)
+    {
+        return hl;
+    }
+
+    return next + strngr_needle_find(needle, &h[next], hl - next);
+}
+
+/* Occurrences of a compiled, non-empty needle in hay, storing the first cap offsets if out is not NULL */
+static uint32_t strngr_needle_each(const strngr_needle_t *needle, const str_view_t hay, uint32_t *out,
+                                   const uint32_t cap, const uint32_t mode)
+{
+    uint32_t n  = 0U;
+    uint32_t at = strngr_needle_find(needle, hay.str, hay.len);
+    while (at < hay.len)
+    {
+        if ((out != NULL) && (n < cap))
+        {
+            out[n] = at;
+        }
+        n++;
+
+        if (mode == STRNGR_OVERLAPPING)
+        {
+            at = strngr_needle_find_next(needle, hay.str, hay.len, at);
+        }
+        else
+        {
+            const uint32_t pos = at + needle->pattern.len;
+            at = pos + strngr_needle_find(needle, &hay.str[pos], hay.len - pos);
+        }
+    }
+
+    return n;
+}
+
+/* Occurrences of needle in hay, storing the first cap offsets if out is not NULL. The needle is compiled once
+ * (rare-byte filter and Two-Way table) rather than on every resumed search. */
+static uint32_t strngr_find_each(const str_view_t hay, const str_view_t needle, uint32_t *out, const uint32_t cap,
+                                 const uint32_t mode)
+{
+    if ((hay.str == NULL) || (needle.str == NULL) || (needle.len == 0U) || (needle.len > hay.len))
+    {
+        return 0U;
+    }
+
+    /* Single bytes cannot overlap, and without offsets to store they are just counted */
+    if ((needle.len == 1U) && (out == NULL))
+    {
+        return strngr_count_byte(hay.str, hay.len, needle.str[0]);
+    }
+
+    strngr_needle_t compiled;
+    const str_t     pattern = {needle.len, needle.len, (char *)needle.str, 0U};
+    (void)strngr_needle_compile(&compiled, pattern);
+
+    return strngr_needle_each(&compiled, hay, out, cap, mode);
+}
+
+/* Resolve strngr_strsub's start/end (negative counts from the end) against len; zero if the range is empty */
+static uint32_t strngr_sub_range(const uint32_t len, const int32_t start, const int32_t end, uint32_t *off,
+                                 uint32_t *sub_len)
+{
+    /* Prevent overflow when casting len to signed */
+    if (len > (uint32_t)INT32_MAX)
+    {
+        return 0U;
+    }
+
+    int32_t src_len = (int32_t)len;
+
+    /* Convert negative start to offset from end */
+    int32_t actual_start = start;
+    if (start < 0)
+    {
+        actual_start = src_len + start;
+    }
+
+    /* Convert negative end to offset from end */
+    int32_t actual_end = end;
+    if (end < 0)
+    {
+        actual_end = src_len + end;
+    }
+
+    /* Clamp positions to valid range */
+    if (actual_start < 0)
+    {
+        actual_start = 0;
+    }
+    if (actual_end > src_len)
+    {
+        actual_end = src_len;
+    }
+
+    /* Check that start is before end */
+    if (actual_start >= actual_end)
+    {
+        return 0U;
+    }
+
+    /* Substring length is guaranteed positive after the above checks */
+    *off     = (uint32_t)actual_start;
+    *sub_len = (uint32_t)(actual_end - actual_start);
+
+    return 1U;
+}
+
+/* Usable length of a buffer; terminated strings keep their last byte for the NUL */
+static uint32_t strngr_capacity(const str_t *str)
+{
+    if (((str->term & STRNGR_FLAG_TERMINATED) != 0U) && (str->max_len != 0U))
+    {
+        return str->max_len - 1U;
+    }
+
+    return str->max_len;
+}
+
+/* Copy the C string src into dst[0..cap), stopping at its terminator; returns the bytes copied. src is read one byte
+ * at a time and never past its terminator or src[cap], the byte that tells whether it was cut short. C99 does not
+ * promise that memchr stops at the first match, so it cannot bound the scan. */
+static uint32_t strngr_cstr_copy(char *dst, const char *src, const uint32_t cap, uint32_t *truncated)
+{
+    uint32_t n = 0U;
+    while (src[n] != '\0')
+    {
+        if (n == cap)
+        {
+            if (truncated != NULL)
+            {
+                *truncated = 1U;
+            }
+            break;
+        }
+        dst[n] = src[n];
+        n++;
+    }
+
+    return n;
+}
+
+/* Bytes of src that fit in dst under strngr_strcpy's rules, with dst's length (and terminator) already set for
+ * them; UINT32_MAX if either string is missing */
+static uint32_t strngr_cpy_len(const str_t src, str_t *dst)
+{
+    if ((src.str == NULL) || (dst == NULL) || (dst->str == NULL))
+    {
+        return UINT32_MAX;
+    }
+
+    uint32_t n = src.len;
+    if (n > strngr_capacity(dst))
+    {
+        n = strngr_capacity(dst);
+    }
+
+    dst->len = n;
+    if ((dst->term & STRNGR_FLAG_TERMINATED) != 0U)
+    {
+        dst->str[n] = '\0';
+    }
+
+    return n;
+}
+
+/* View of src[off..off + sub_len), as returned by strngr_strsub and the trim functions */
+static str_t strngr_view_at(const str_t src, const uint32_t off, const uint32_t sub_len)
+{
+    str_t result = {sub_len, sub_len, &src.str[off], src.term};
+
+    /* A view that stops short of the end no longer sits in front of the terminator */
+    if ((off + sub_len) != src.len)
+    {
+        result.term &= ~STRNGR_FLAG_TERMINATED;
+    }
+
+    return result;
+}
+
+/* Ends stripped by strngr_trim_span */
+#define STRNGR_TRIM_LEFT  (1U)
+#define STRNGR_TRIM_RIGHT (2U)
+
+/* Length of s[0..len) left after stripping set members (ASCII whitespace if set is NULL) from the chosen ends;
+ * *off receives the number of bytes stripped from the front */
+static uint32_t strngr_trim_span(const char *s, const uint32_t len, const strngr_byteset_t *set, const uint32_t ends,
+                                 uint32_t *off)
+{
+    const strngr_byteset_t *ws    = (set != NULL) ? set : &strngr_ws_set;
+    uint32_t                start = 0U;
+    uint32_t                end   = len;
+
+    if ((ends & STRNGR_TRIM_LEFT) != 0U)
+    {
+        start = strngr_find_class(s, len, ws, 0U);
+    }
+
+    if (((ends & STRNGR_TRIM_RIGHT) != 0U) && (start < len))
+    {
+        const uint32_t last = strngr_find_class_last(&s[start], len - start, ws, 0U);
+        end                 = (last < (len - start)) ? (start + last + 1U) : start;
+    }
+
+    *off = start;
+    return (start < end) ? (end - start) : 0U;
+}
+
+static str_t strngr_trim_str(const str_t src, const strngr_byteset_t *set, const uint32_t ends)
+{
+    str_t    result = {0U, 0U, NULL, 0U};
+    uint32_t off    = 0U;
+
+    if (src.str == NULL)
+    {
+        return result;
+    }
+
+    const uint32_t sub_len = strngr_trim_span(src.str, src.len, set, ends, &off);
+    return strngr_view_at(src, off, sub_len);
+}
+
+static str_view_t strngr_view_trim_ends(const str_view_t src, const strngr_byteset_t *set, const uint32_t ends)
+{
+    str_view_t result = {NULL, 0U};
+    uint32_t   off    = 0U;
+
+    if (src.str == NULL)
+    {
+        return result;
+    }
+
+    result.len = strngr_trim_span(src.str, src.len, set, ends, &off);
+    result.str = &src.str[off];
+
+    return result;
+}
+
+/* View from hay[pos] to the end of the haystack, as returned by the search functions */
+static str_t strngr_view_from(const str_t hay, const uint32_t pos)
+{
+    str_t result = {hay.len - pos, hay.len - pos, &hay.str[pos], hay.term};
+    return result;
+}
+
+/* Marks a DFA transition whose target state reports at least one match */
+#define STRNGR_MULTI_EMIT (0x80000000UL)
+#define STRNGR_MULTI_NONE (UINT32_MAX)
+
+/* Bytes of arena needed for the automaton: transition table, per-state output/dictionary links and depths,
+ * duplicate-pattern chains and the BFS scratch used while building. Zero if it does not fit. */
+static uint32_t strngr_multi_dfa_size(const str_t *patterns, const uint32_t count, uint32_t *states, uint32_t *classes)
+{
+    uint8_t  seen[256];
+    uint64_t s  = 1U;
+    uint32_t nc = 1U;
+
+    memset((void *)seen, 0, sizeof(seen));
+    for (uint32_t p = 0U; p < count; p++)
+    {
+        if ((patterns[p].str == NULL) || (patterns[p].len == 0U))
+        {
+            return 0U;
+        }
+
+        s += patterns[p].len;
+        for (uint32_t i = 0U; i < patterns[p].len; i++)
+        {
+            const uint8_t b = (uint8_t)patterns[p].str[i];
+            if (seen[b] == 0U)
+            {
+                seen[b] = 1U;
+                nc++;
+            }
+        }
+    }
+
+    const uint64_t words = (s * nc) + (s * 7U) + count;
+    if ((s > (STRNGR_MULTI_EMIT / nc)) || (words > ((UINT32_MAX - 4U) / 4U)))
+    {
+        return 0U;
+    }
+
+    *states  = (uint32_t)s;
+    *classes = nc;
+    return (uint32_t)(words * 4U) + 4U;
+}
+
+/* Aho-Corasick over byte classes, flattened into a full DFA */
+static strngr_multi_t *strngr_multi_build_dfa(strngr_multi_t *multi, void *mem, const uint32_t mem_len)
+{
+    uint32_t max_states = 0U;
+    uint32_t nc         = 0U;
+    uint32_t need       = strngr_multi_dfa_size(multi->patterns, multi->count, &max_states, &nc);
+
+    if ((need == 0U) || (mem_len < need))
+    {
+        return NULL;
+    }
+
+    /* Carve the arena on a 4-byte boundary */
+    uint8_t        *base  = (uint8_t *)mem;
+    const uintptr_t align = ((uintptr_t)base) & 3U;
+    if (align != 0U)
+    {
+        base += 4U - align;
+    }
+
+    uint32_t *trans = (uint32_t *)(void *)base;
+    uint32_t *out   = &trans[max_states * nc];
+    uint32_t *dict  = &out[max_states];
+    uint32_t *depth = &dict[max_states];
+    uint32_t *next  = &depth[max_states];
+    uint32_t *fail  = &next[multi->count];
+    uint32_t *queue = &fail[max_states];
+    uint32_t *ends  = &queue[max_states];
+    uint32_t *occ   = &ends[max_states];
+
+    memset((void *)multi->class_map, 0, sizeof(multi->class_map));
+    nc = 1U;
+    for (uint32_t p = 0U; p < multi->count; p++)
+    {
+        for (uint32_t i = 0U; i < multi->patterns[p].len; i++)
+        {
+            const uint8_t b = (uint8_t)multi->patterns[p].str[i];
+            if (multi->class_map[b] == 0U)
+            {
+                multi->class_map[b] = (uint16_t)nc;
+                nc++;
+            }
+        }
+    }
+
+    /* Trie */
+    uint32_t states = 1U;
+    for (uint32_t c = 0U; c < nc; c++)
+    {
+        trans[c] = STRNGR_MULTI_NONE;
+    }
+    out[0]   = STRNGR_MULTI_NONE;
+    dict[0]  = 0U;
+    depth[0] = 0U;
+
+    for (uint32_t p = 0U; p < multi->count; p++)
+    {
+        uint32_t s = 0U;
+        for (uint32_t i = 0U; i < multi->patterns[p].len; i++)
+        {
+            const uint32_t c = multi->class_map[(uint8_t)multi->patterns[p].str[i]];
+            if (trans[(s * nc) + c] == STRNGR_MULTI_NONE)
+            {
+                for (uint32_t k = 0U; k < nc; k++)
+                {
+                    trans[(states * nc) + k] = STRNGR_MULTI_NONE;
+                }
+                out[states]              = STRNGR_MULTI_NONE;
+                dict[states]             = 0U;
+                depth[states]            = depth[s] + 1U;
+                trans[(s * nc) + c]      = states;
+                states++;
+            }
+            s = trans[(s * nc) + c];
+        }
+
+        /* Duplicate patterns chain off the same state */
+        next[p] = out[s];
+        out[s]  = p;
+    }
+
+    /* Breadth-first failure links; missing transitions borrow from the failure state. Alongside, ends[t] counts
+     * the patterns that end at t and occ[t] the pattern occurrences inside t's string: matches wait to be
+     * reported in start order only while they lie inside the current state, so the largest occ[] bounds how many
+     * can be pending at once. */
+    uint32_t head  = 0U;
+    uint32_t tail  = 0U;
+    ends[0]        = 0U;
+    occ[0]         = 0U;
+    multi->pending = 0U;
+    for (uint32_t c = 0U; c < nc; c++)
+    {
+        const uint32_t t = trans[c];
+        if (t == STRNGR_MULTI_NONE)
+        {
+            trans[c] = 0U;
+        }
+        else
+        {
+            fail[t]       = 0U;
+            ends[t]       = 0U;
+            occ[t]        = 0U;
+            queue[tail++] = t;
+        }
+    }
+
+    while (head < tail)
+    {
+        const uint32_t s = queue[head++];
+
+        /* dict[s] is shallower than s, so its count is already final; occ[s] holds the parent's count */
+        for (uint32_t p = out[s]; p != STRNGR_MULTI_NONE; p = next[p])
+        {
+            ends[s]++;
+        }
+        ends[s] += ends[dict[s]];
+        occ[s] += ends[s];
+        if (occ[s] > multi->pending)
+        {
+            multi->pending = occ[s];
+        }
+
+        for (uint32_t c = 0U; c < nc; c++)
+        {
+            const uint32_t t = trans[(s * nc) + c];
+            const uint32_t f = trans[(fail[s] * nc) + c];
+            if (t == STRNGR_MULTI_NONE)
+            {
+                trans[(s * nc) + c] = f;
+            }
+            else
+            {
+                fail[t]       = f;
+                dict[t]       = (out[f] != STRNGR_MULTI_NONE) ? f : dict[f];
+                ends[t]       = 0U;
+                occ[t]        = occ[s];
+                queue[tail++] = t;
+            }
+        }
+    }
+
+    /* Pre-multiply targets into row offsets and flag the ones that report */
+    for (uint32_t i = 0U; i < (states * nc); i++)
+    {
+        const uint32_t t = trans[i];
+        trans[i]         = t * nc;
+        if ((out[t] != STRNGR_MULTI_NONE) || (dict[t] != 0U))
+        {
+            trans[i] |= STRNGR_MULTI_EMIT;
+        }
+    }
+
+    multi->engine  = STRNGR_MULTI_DFA;
+    multi->states  = states;
+    multi->classes = nc;
+    multi->trans   = trans;
+    multi->out     = out;
+    multi->dict    = dict;
+    multi->depth   = depth;
+    multi->next    = next;
+
+    return multi;
+}
+
+#if defined(STRNGR_SSSE3)
+/* Teddy: nibble-indexed bucket masks for the first bytes of up to 8 patterns, one bucket each */
+static strngr_multi_t *strngr_multi_build_teddy(strngr_multi_t *multi)
+{
+    uint32_t prefix = 3U;
+    for (uint32_t p = 0U; p < multi->count; p++)
+    {
+        if ((multi->patterns[p].str == NULL) || (multi->patterns[p].len == 0U))
+        {
+            return NULL;
+        }
+        if (multi->patterns[p].len < prefix)
+        {
+            prefix = multi->patterns[p].len;
+        }
+    }
+
+    memset((void *)multi->teddy_lo, 0, sizeof(multi->teddy_lo));
+    memset((void *)multi->teddy_hi, 0, sizeof(multi->teddy_hi));
+    for (uint32_t p = 0U; p < multi->count; p++)
+    {
+        for (uint32_t k = 0U; k < prefix; k++)
+        {
+            const uint8_t b = (uint8_t)multi->patterns[p].str[k];
+            multi->teddy_lo[k][b & 15U] |= (uint8_t)(1U << p);
+            multi->teddy_hi[k][b >> 4U] |= (uint8_t)(1U << p);
+        }
+    }
+
+    multi->engine     = STRNGR_MULTI_TEDDY;
+    multi->teddy_len  = prefix;
+    return multi;
+}
+
+/* Verify every bucket in mask at hay position at; non-zero if the callback asked to stop */
+static uint32_t strngr_multi_teddy_verify(const strngr_multi_t *multi, const str_view_t hay, const uint32_t at,
+                                          uint32_t mask, strngr_match_cb_t fn, void *ctx, uint32_t *found)
+{
+    while (mask != 0U)
+    {
+        const uint32_t p   = strngr_ctz32(mask);
+        const str_t   *pat = &multi->patterns[p];
+        mask &= mask - 1U;
+
+        if (((hay.len - at) >= pat->len) &&
+            (memcmp((const void *)&hay.str[at], (const void *)pat->str, (size_t)pat->len) == 0))
+        {
+            const strngr_match_t match = {p, at};
+            (*found)++;
+            if (fn(ctx, &match) != 0U)
+            {
+                return 1U;
+            }
+        }
+    }
+
+    return 0U;
+}
+
+static uint32_t strngr_multi_scan_teddy(const strngr_multi_t *multi, const str_view_t hay, strngr_match_cb_t fn,
+                                        void *ctx)
+{
+    const uint32_t m     = multi->teddy_len;
+    uint32_t       found = 0U;
+    uint32_t       i     = 0U;
+
+    if (hay.len < m)
+    {
+        return 0U;
+    }
+
+    const __m128i nib = _mm_set1_epi8(0x0F);
+    const __m128i lo0 = _mm_loadu_si128((const __m128i *)multi->teddy_lo[0]);
+    const __m128i hi0 = _mm_loadu_si128((const __m128i *)multi->teddy_hi[0]);
+    const __m128i lo1 = _mm_loadu_si128((const __m128i *)multi->teddy_lo[1]);
+    const __m128i hi1 = _mm_loadu_si128((const __m128i *)multi->teddy_hi[1]);
+    const __m128i lo2 = _mm_loadu_si128((const __m128i *)multi->teddy_lo[2]);
+    const __m128i hi2 = _mm_loadu_si128((const __m128i *)multi->teddy_hi[2]);
+
+    /* Unused prefix positions have all-zero tables, so they are simply not ANDed in */
+    for (; (hay.len - i) >= (16U + m - 1U); i += 16U)
+    {
+        __m128i c   = _mm_loadu_si128((const __m128i *)&hay.str[i]);
+        __m128i acc = _mm_and_si128(_mm_shuffle_epi8(lo0, _mm_and_si128(c, nib)),
+                                    _mm_shuffle_epi8(hi0, _mm_and_si128(_mm_srli_epi16(c, 4), nib)));
+        if (m > 1U)
+        {
+            c   = _mm_loadu_si128((const __m128i *)&hay.str[i + 1U]);
+            acc = _mm_and_si128(acc, _mm_and_si128(_mm_shuffle_epi8(lo1, _mm_and_si128(c, nib)),
+                                                   _mm_shuffle_epi8(hi1, _mm_and_si128(_mm_srli_epi16(c, 4), nib))));
+        }
+        if (m > 2U)
+        {
+            c   = _mm_loadu_si128((const __m128i *)&hay.str[i + 2U]);
+            acc = _mm_and_si128(acc, _mm_and_si128(_mm_shuffle_epi8(lo2, _mm_and_si128(c, nib)),
+                                                   _mm_shuffle_epi8(hi2, _mm_and_si128(_mm_srli_epi16(c, 4), nib))));
+        }
+
+        uint32_t hits = 0xFFFFU ^ (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128()));
+        if (hits == 0U)
+        {
+            continue;
+        }
+
+        uint8_t buckets[16];
+        _mm_storeu_si128((__m128i *)buckets, acc);
+        while (hits != 0U)
+        {
+            const uint32_t j = strngr_ctz32(hits);
+            hits &= hits - 1U;
+            if (strngr_multi_teddy_verify(multi, hay, i + j, buckets[j], fn, ctx, &found) != 0U)
+            {
+                return found;
+            }
+        }
+    }
+
+    for (; i <= (hay.len - m); i++)
+    {
+        uint32_t mask = 0xFFU;
+        for (uint32_t k = 0U; k < m; k++)
+        {
+            const uint8_t b = (uint8_t)hay.str[i + k];
+            mask &= (uint32_t)multi->teddy_lo[k][b & 15U] & (uint32_t)multi->teddy_hi[k][b >> 4U];
+        }
+        if ((mask != 0U) && (strngr_multi_teddy_verify(multi, hay, i, mask, fn, ctx, &found) != 0U))
+        {
+            return found;
+        }
+    }
+
+    return found;
+}
+#endif
+
+/* Matches of the DFA scan waiting for every earlier-starting match to be found */
+#define STRNGR_MULTI_PENDING (64U)
+
+/* Insert match into p[0..n), kept ordered by offset and then pattern */
+static void strngr_multi_pend(strngr_match_t *p, const uint32_t n, const strngr_match_t match)
+{
+    uint32_t k = n;
+    while ((k > 0U) && ((p[k - 1U].offset > match.offset) ||
+                        ((p[k - 1U].offset == match.offset) && (p[k - 1U].pattern > match.pattern))))
+    {
+        p[k] = p[k - 1U];
+        k--;
+    }
+    p[k] = match;
+}
+
+/* Report p[0..n) while their offsets are below limit; returns how many were reported, or UINT32_MAX if the callback
+ * asked to stop */
+static uint32_t strngr_multi_release(strngr_match_t *p, const uint32_t n, const uint32_t limit, strngr_match_cb_t fn,
+                                     void *ctx, uint32_t *found)
+{
+    uint32_t k = 0U;
+    for (; (k < n) && (p[k].offset < limit); k++)
+    {
+        (*found)++;
+        if (fn(ctx, &p[k]) != 0U)
+        {
+            return UINT32_MAX;
+        }
+    }
+
+    if (k != 0U)
+    {
+        memmove((void *)p, (const void *)&p[k], (size_t)(n - k) * sizeof(*p));
+    }
+    return k;
+}
+
+/* Start-ordered scan for sets whose matches can nest too deeply for the pending buffer: walk the trie from every
+ * position and report the patterns starting there, lowest index first */
+static uint32_t strngr_multi_scan_walk(const strngr_multi_t *multi, const str_view_t hay, strngr_match_cb_t fn,
+                                       void *ctx)
+{
+    const uint8_t *h     = (const uint8_t *)hay.str;
+    const uint32_t nc    = multi->classes;
+    uint32_t       found = 0U;
+
+    for (uint32_t q = 0U; q < hay.len; q++)
+    {
+        uint32_t last = STRNGR_MULTI_NONE;
+        for (;;)
+        {
+            uint32_t best = STRNGR_MULTI_NONE;
+            uint32_t row  = 0U;
+            for (uint32_t j = q; j < hay.len; j++)
+            {
+                const uint32_t next = multi->trans[row + multi->class_map[h[j]]] & ~STRNGR_MULTI_EMIT;
+                if (multi->depth[next / nc] != (j - q + 1U))
+                {
+                    break;
+                }
+                row = next;
+                for (uint32_t p = multi->out[row / nc]; p != STRNGR_MULTI_NONE; p = multi->next[p])
+                {
+                    if (((last == STRNGR_MULTI_NONE) || (p > last)) && ((best == STRNGR_MULTI_NONE) || (p < best)))
+                    {
+                        best = p;
+                    }
+                }
+            }
+            if (best == STRNGR_MULTI_NONE)
+            {
+                break;
+            }
+
+            const strngr_match_t match = {best, q};
+            found++;
+            if (fn(ctx, &match) != 0U)
+            {
+                return found;
+            }
+            last = best;
+        }
+    }
+
+    return found;
+}
+
+/* The DFA finds matches by where they end. They are held back, ordered, until the current state's string starts
+ * past them: that start never moves backwards, and every match still to come begins at or after it. */
+static uint32_t strngr_multi_scan_dfa(const strngr_multi_t *multi, const str_view_t hay, strngr_match_cb_t fn,
+                                      void *ctx)
+{
+    if (multi->pending > STRNGR_MULTI_PENDING)
+    {
+        return strngr_multi_scan_walk(multi, hay, fn, ctx);
+    }
+
+    const uint32_t *trans = multi->trans;
+    const uint8_t  *h     = (const uint8_t *)hay.str;
+    strngr_match_t  pend[STRNGR_MULTI_PENDING];
+    uint32_t        npend = 0U;
+    uint32_t        found = 0U;
+    uint32_t        row   = 0U;
+
+    for (uint32_t i = 0U; i < hay.len; i++)
+    {
+        row = trans[row + multi->class_map[h[i]]];
+        if ((npend == 0U) && ((row & STRNGR_MULTI_EMIT) == 0U))
+        {
+            continue;
+        }
+
+        const uint32_t emit = row & STRNGR_MULTI_EMIT;
+        row &= ~STRNGR_MULTI_EMIT;
+        uint32_t s = row / multi->classes;
+
+        if (npend != 0U)
+        {
+            const uint32_t done = strngr_multi_release(pend, npend, i + 1U - multi->depth[s], fn, ctx, &found);
+            if (done == UINT32_MAX)
+            {
+                return found;
+            }
+            npend -= done;
+        }
+
+        if (emit == 0U)
+        {
+            continue;
+        }
+
+        if (multi->out[s] == STRNGR_MULTI_NONE)
+        {
+            s = multi->dict[s];
+        }
+
+        /* Walk the dictionary suffix links, queueing every pattern ending here */
+        while (s != 0U)
+        {
+            for (uint32_t p = multi->out[s]; p != STRNGR_MULTI_NONE; p = multi->next[p])
+            {
+                const strngr_match_t match = {p, i + 1U - multi->patterns[p].len};
+                strngr_multi_pend(pend, npend, match);
+                npend++;
+            }
+            s = multi->dict[s];
+        }
+    }
+
+    (void)strngr_multi_release(pend, npend, UINT32_MAX, fn, ctx, &found);
+    return found;
+}
+
+typedef struct
+{
+    strngr_match_t *out;
+    uint32_t        cap;
+    uint32_t        used;
+} strngr_multi_collect_t;
+
+static uint32_t strngr_multi_collect(void *ctx, const strngr_match_t *match)
+{
+    strngr_multi_collect_t *c = (strngr_multi_collect_t *)ctx;
+
+    c->out[c->used] = *match;
+    c->used++;
+
+    /* Stop scanning once the result array is full */
+    return (c->used >= c->cap) ? 1U : 0U;
+}
+
+/* wyhash-style mixing: 64x64 -> 128-bit multiply, folded back to 64 bits */
+static const uint64_t strngr_hash_secret[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL,
+                                               0x4d5a2da51de1aa47ULL};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 strngr_u128_t;
+#endif
+
+static void strngr_hash_mum(uint64_t *a, uint64_t *b)
+{
+#if defined(__SIZEOF_INT128__)
+    const strngr_u128_t r = (strngr_u128_t)*a * (strngr_u128_t)*b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64U);
+#else
+    const uint64_t ha = *a >> 32U;
+    const uint64_t hb = *b >> 32U;
+    const uint64_t la = (uint32_t)*a;
+    const uint64_t lb = (uint32_t)*b;
+    const uint64_t rm0 = ha * lb;
+    const uint64_t rm1 = hb * la;
+    const uint64_t rl  = la * lb;
+    const uint64_t t   = rl + (rm0 << 32U);
+    const uint64_t lo  = t + (rm1 << 32U);
+    const uint64_t c   = ((t < rl) ? 1U : 0U) + ((lo < t) ? 1U : 0U);
+    *a = lo;
+    *b = (ha * hb) + (rm0 >> 32U) + (rm1 >> 32U) + c;
+#endif
+}
+
+static uint64_t strngr_hash_mix(uint64_t a, uint64_t b)
+{
+    strngr_hash_mum(&a, &b);
+    return a ^ b;
+}
+
+static uint64_t strngr_hash_load64(const uint32_t fold, const uint8_t *p)
+{
+    const uint64_t v = strngr_load_le64(p);
+    return (fold != 0U) ? strngr_fold64(v) : v;
+}
+
+static uint64_t strngr_hash_load32(const uint32_t fold, const uint8_t *p)
+{
+    const uint64_t v = strngr_load_le32(p);
+    return (fold != 0U) ? strngr_fold64(v) : v;
+}
+
+/* Hash of src, with every byte ASCII case-folded as it is loaded when fold is set */
+static uint64_t strngr_hash_bytes(const str_view_t src, const uint64_t seed, const uint32_t fold)
+{
+    const uint8_t *p   = (const uint8_t *)src.str;
+    const uint64_t len = (p == NULL) ? 0U : (uint64_t)src.len;
+    uint64_t       a   = 0U;
+    uint64_t       b   = 0U;
+    uint64_t       s   = seed ^ strngr_hash_mix(seed ^ strngr_hash_secret[0], strngr_hash_secret[1]);
+
+    if (len <= 16U)
+    {
+        /* Short keys: two overlapping reads from each end cover every byte without a loop */
+        if (len >= 4U)
+        {
+            const uint64_t q = (len >> 3U) << 2U;
+            a = (strngr_hash_load32(fold, p) << 32U) | strngr_hash_load32(fold, &p[q]);
+            b = (strngr_hash_load32(fold, &p[len - 4U]) << 32U) | strngr_hash_load32(fold, &p[len - 4U - q]);
+        }
+        else if (len > 0U)
+        {
+            const uint8_t c0 = (fold != 0U) ? strngr_fold_byte(p[0]) : p[0];
+            const uint8_t c1 = (fold != 0U) ? strngr_fold_byte(p[len >> 1U]) : p[len >> 1U];
+            const uint8_t c2 = (fold != 0U) ? strngr_fold_byte(p[len - 1U]) : p[len - 1U];
+            a = ((uint64_t)c0 << 16U) | ((uint64_t)c1 << 8U) | (uint64_t)c2;
+        }
+    }
+    else
+    {
+        uint64_t i   = len;
+        uint64_t off = 0U;
+
+        /* Three independent lanes keep the multipliers busy on long keys */
+        if (i >= 48U)
+        {
+            uint64_t s1 = s;
+            uint64_t s2 = s;
+            do
+            {
+                const uint8_t *q = &p[off];
+                s   = strngr_hash_mix(strngr_hash_load64(fold, q) ^ strngr_hash_secret[1],
+                                      strngr_hash_load64(fold, &q[8]) ^ s);
+                s1  = strngr_hash_mix(strngr_hash_load64(fold, &q[16]) ^ strngr_hash_secret[2],
+                                      strngr_hash_load64(fold, &q[24]) ^ s1);
+                s2  = strngr_hash_mix(strngr_hash_load64(fold, &q[32]) ^ strngr_hash_secret[3],
+                                      strngr_hash_load64(fold, &q[40]) ^ s2);
+                off += 48U;
+                i -= 48U;
+            } while (i >= 48U);
+            s ^= s1 ^ s2;
+        }
+
+        while (i > 16U)
+        {
+            s = strngr_hash_mix(strngr_hash_load64(fold, &p[off]) ^ strngr_hash_secret[1],
+                                strngr_hash_load64(fold, &p[off + 8U]) ^ s);
+            off += 16U;
+            i -= 16U;
+        }
+
+        /* The last 16 bytes of the key, overlapping what was already mixed */
+        a = strngr_hash_load64(fold, &p[len - 16U]);
+        b = strngr_hash_load64(fold, &p[len - 8U]);
+    }
+
+    a ^= strngr_hash_secret[1];
+    b ^= s;
+    strngr_hash_mum(&a, &b);
+
+    return strngr_hash_mix(a ^ strngr_hash_secret[0] ^ len, b ^ strngr_hash_secret[1]);
+}
+
+/* Control bytes: EMPTY and DELETED have the top bit set, a full slot holds the low 7 bits of its hash */
+#define STRNGR_MAP_EMPTY   (0x80U)
+#define STRNGR_MAP_DELETED (0xFEU)
+#define STRNGR_MAP_NONE    (UINT32_MAX)
+
+/* Bit i set where ctrl[i] == b, over one group */
+static uint32_t strngr_map_match(const uint8_t *ctrl, const uint8_t b)
+{
+#if defined(STRNGR_SSE2)
+    const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)b)));
+#else
+    uint32_t m = 0U;
+    for (uint32_t i = 0U; i < STRNGR_MAP_GROUP; i++)
+    {
+        m |= (ctrl[i] == b) ? (1U << i) : 0U;
+    }
+    return m;
+#endif
+}
+
+/* Bit i set where slot i of the group is EMPTY or DELETED */
+static uint32_t strngr_map_match_free(const uint8_t *ctrl)
+{
+#if defined(STRNGR_SSE2)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#else
+    uint32_t m = 0U;
+    for (uint32_t i = 0U; i < STRNGR_MAP_GROUP; i++)
+    {
+        m |= ((ctrl[i] & 0x80U) != 0U) ? (1U << i) : 0U;
+    }
+    return m;
+#endif
+}
+
+/* Slot holding key, or STRNGR_MAP_NONE. Groups are visited in triangular order, which covers every group of a
+ * power-of-two table; the first group with an EMPTY slot ends the probe. */
+static uint32_t strngr_map_probe(const strngr_map_t *map, const str_view_t key, const uint64_t hash)
+{
+    const uint32_t mask = (map->capacity / STRNGR_MAP_GROUP) - 1U;
+    const uint8_t  h2   = (uint8_t)(hash & 0x7FU);
+    uint32_t       g    = (uint32_t)(hash >> 7U) & mask;
+
+    for (uint32_t step = 1U; step <= (mask + 1U); step++)
+    {
+        const uint8_t *ctrl = &map->ctrl[g * STRNGR_MAP_GROUP];
+        for (uint32_t m = strngr_map_match(ctrl, h2); m != 0U; m &= m - 1U)
+        {
+            const uint32_t            slot  = (g * STRNGR_MAP_GROUP) + strngr_ctz32(m);
+            const strngr_map_entry_t *entry = &map->entries[slot];
+            if ((entry->hash == hash) && (strngr_view_equal(entry->key, key) != 0U))
+            {
+                return slot;
+            }
+        }
+
+        if (strngr_map_match(ctrl, (uint8_t)STRNGR_MAP_EMPTY) != 0U)
+        {
+            break;
+        }
+        g = (g + step) & mask;
+    }
+
+    return STRNGR_MAP_NONE;
+}
+
+/* First EMPTY or DELETED slot on the probe sequence of hash */
+static uint32_t strngr_map_probe_free(const strngr_map_t *map, const uint64_t hash)
+{
+    const uint32_t mask = (map->capacity / STRNGR_MAP_GROUP) - 1U;
+    uint32_t       g    = (uint32_t)(hash >> 7U) & mask;
+
+    for (uint32_t step = 1U; step <= (mask + 1U); step++)
+    {
+        const uint32_t m = strngr_map_match_free(&map->ctrl[g * STRNGR_MAP_GROUP]);
+        if (m != 0U)
+        {
+            return (g * STRNGR_MAP_GROUP) + strngr_ctz32(m);
+        }
+        g = (g + step) & mask;
+    }
+
+    return STRNGR_MAP_NONE;
+}
+
+/* Slot count for a requested capacity: a power of two, at least 16; zero if slot_size bytes per slot, plus
+ * alignment slack, would not stay addressable with 32-bit sizes */
+static uint32_t strngr_table_slots(const uint32_t capacity, const uint32_t slot_size)
+{
+    uint64_t slots = 16U;
+
+    while (slots < (uint64_t)capacity)
+    {
+        slots <<= 1U;
+    }
+
+    if ((slots * (uint64_t)slot_size) > ((uint64_t)UINT32_MAX - 64U))
+    {
+        return 0U;
+    }
+
+    return (uint32_t)slots;
+}
+
+/* Map slots are a control byte plus an entry */
+#define STRNGR_MAP_SLOT_SIZE ((uint32_t)(1U + sizeof(strngr_map_entry_t)))
+
+/* Interned strings are stored as this header followed by the bytes and a NUL */
+typedef struct
+{
+    uint64_t hash;
+    uint32_t len;
+    uint32_t reserved;
+} strngr_intern_entry_t;
+
+/* Atomic pointer publication and the insert lock. Slots only ever go from NULL to a finished entry, so readers
+ * need nothing stronger than an acquire load. */
+#if defined(__GNUC__) || defined(__clang__)
+#define STRNGR_LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STRNGR_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define STRNGR_TRY_LOCK(l)         (__atomic_exchange_n((l), 1U, __ATOMIC_ACQUIRE) == 0U)
+#define STRNGR_UNLOCK(l)           __atomic_store_n((l), 0U, __ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+#define STRNGR_LOAD_ACQUIRE(p)     (*(const void *volatile *)(p))
+#define STRNGR_STORE_RELEASE(p, v) ((void)_InterlockedExchangePointer((void *volatile *)(p), (void *)(v)))
+#define STRNGR_TRY_LOCK(l)         (_InterlockedExchange((volatile long *)(l), 1L) == 0L)
+#define STRNGR_UNLOCK(l)           ((void)_InterlockedExchange((volatile long *)(l), 0L))
+#else
+#error "strngr_intern_t needs atomic builtins (GCC, Clang or MSVC)"
+#endif
+
+static void strngr_intern_lock(strngr_intern_t *pool)
+{
+    while (!STRNGR_TRY_LOCK(&pool->lock))
+    {
+#if defined(STRNGR_SSE2)
+        _mm_pause();
+#endif
+    }
+}
+
+/* Canonical entry for key, or NULL. Linear probing with no deletions, so the first empty slot ends the search and
+ * a lookup costs at most capacity loads whatever the writers are doing. */
+static const strngr_intern_entry_t *strngr_intern_probe(const strngr_intern_t *pool, const str_view_t key,
+                                                        const uint64_t hash, uint32_t *slot)
+{
+    const uint32_t mask = pool->capacity - 1U;
+    uint32_t       i    = (uint32_t)hash & mask;
+
+    *slot = STRNGR_MAP_NONE;
+    for (uint32_t n = 0U; n < pool->capacity; n++)
+    {
+        const strngr_intern_entry_t *entry = (const strngr_intern_entry_t *)STRNGR_LOAD_ACQUIRE(&pool->slots[i]);
+        if (entry == NULL)
+        {
+            *slot = i;
+            break;
+        }
+        if ((entry->hash == hash) && (entry->len == key.len) &&
+            (memcmp((const void *)&entry[1], (const void *)key.str, (size_t)key.len) == 0))
+        {
+            return entry;
+        }
+        i = (i + 1U) & mask;
+    }
+
+    return NULL;
+}
+
+static str_view_t strngr_intern_view(const strngr_intern_entry_t *entry)
+{
+    str_view_t result = {NULL, 0U};
+
+    if (entry != NULL)
+    {
+        result.str = (const char *)&entry[1];
+        result.len = entry->len;
+    }
+
+    return result;
+}
+
+/* Buffer the next batch of newline positions; leaves count at zero only once the input is exhausted */
+static void strngr_lines_fill(strngr_lines_t *it)
+{
+    const char    *s   = it->src.str;
+    const uint32_t len = it->src.len;
+
+    it->head  = 0U;
+    it->count = 0U;
+    while ((it->count == 0U) && (it->scan < len))
+    {
+        const uint32_t base = it->scan;
+        uint64_t       m    = 0U;
+
+        if ((len - base) >= 64U)
+        {
+            m = strngr_mask64(&s[base], '\n');
+            it->scan += 64U;
+        }
+        else
+        {
+            for (uint32_t i = base; i < len; i++)
+            {
+                m |= (s[i] == '\n') ? (1ULL << (i - base)) : 0U;
+            }
+            it->scan = len;
+        }
+
+        /* At most 64 positions per block, which is the size of the buffer */
+        for (; m != 0U; m &= m - 1U)
+        {
+            it->nl[it->count] = base + strngr_ctz64(m);
+            it->count++;
+        }
+    }
+}
+
+/* Forwards matches from one stream search to the caller with absolute offsets. In the boundary window only
+ * matches that start in the carried bytes and end in the new chunk are new; the rest were reported already or
+ * will be found in the chunk itself. */
+typedef struct
+{
+    strngr_stream_t   *st;
+    strngr_stream_cb_t fn;
+    void              *ctx;
+    uint64_t           base;
+    uint32_t           window;
+    uint32_t           found;
+} strngr_stream_relay_t;
+
+static uint32_t strngr_stream_relay(void *ctx, const strngr_match_t *match)
+{
+    strngr_stream_relay_t *r = (strngr_stream_relay_t *)ctx;
+
+    if (r->window != 0U)
+    {
+        const uint32_t len = (r->st->multi != NULL) ? r->st->multi->patterns[match->pattern].len
+                                                     : r->st->needle->pattern.len;
+        if ((match->offset >= r->st->carry) || ((match->offset + len) <= r->st->carry))
+        {
+            return 0U;
+        }
+    }
+
+    const strngr_stream_match_t out = {match->pattern, r->base + match->offset};
+    r->found++;
+    if (r->fn(r->ctx, &out) != 0U)
+    {
+        r->st->stopped = 1U;
+        return 1U;
+    }
+
+    return 0U;
+}
+
+/* Every occurrence in h, overlapping ones included, in order of start and then pattern index */
+static void strngr_stream_search(strngr_stream_relay_t *r, const str_view_t h)
+{
+    if (r->st->multi != NULL)
+    {
+        (void)strngr_view_multi_scan(r->st->multi, h, strngr_stream_relay, (void *)r);
+        return;
+    }
+
+    uint32_t at = strngr_needle_find(r->st->needle, h.str, h.len);
+    while (at < h.len)
+    {
+        const strngr_match_t match = {0U, at};
+        if (strngr_stream_relay((void *)r, &match) != 0U)
+        {
+            break;
+        }
+        at = strngr_needle_find_next(r->st->needle, h.str, h.len, at);
+    }
+}
+
+/* How a split iterator finds its separators */
+#define STRNGR_SPLIT_MODE_BYTE   (1U)
+#define STRNGR_SPLIT_MODE_SET    (2U)
+#define STRNGR_SPLIT_MODE_STRING (3U)
+
+/* Offset of the first separator in p[0..n), or n */
+static uint32_t strngr_split_scan(const strngr_split_iter_t *it, const char *p, const uint32_t n)
+{
+    if (it->mode == STRNGR_SPLIT_MODE_BYTE)
+    {
+        return strngr_find_byte(p, n, it->sep.str[0]);
+    }
+
+    if (it->mode == STRNGR_SPLIT_MODE_STRING)
+    {
+        return strngr_find_sub(p, n, it->sep.str, it->sep.len);
+    }
+
+    return strngr_find_class(p, n, &it->set, 1U);
+}
+
+/* Position of the separator that ends the token starting at from, or src.len if it is the last one */
+static uint32_t strngr_split_find(const strngr_split_iter_t *it, const uint32_t from)
+{
+    const char    *s   = it->src.str;
+    const uint32_t len = it->src.len;
+    uint32_t       sep = from + strngr_split_scan(it, &s[from], len - from);
+
+    if ((it->flags & STRNGR_SPLIT_QUOTED) == 0U)
+    {
+        return sep;
+    }
+
+    /* A separator only counts if no quote opens before it. Each quoted section is skipped whole, and the
+     * separator is only searched for again when it was inside the section. */
+    uint32_t i = from;
+    for (;;)
+    {
+        const uint32_t q = i + strngr_find_byte(&s[i], sep - i, it->quote);
+        if (q >= sep)
+        {
+            return sep;
+        }
+
+        const uint32_t close = q + 1U + strngr_find_byte(&s[q + 1U], len - q - 1U, it->quote);
+        if (close >= len)
+        {
+            /* Unterminated quote: the rest of the input is one token */
+            return len;
+        }
+
+        i = close + 1U;
+        if (sep < i)
+        {
+            sep = i + strngr_split_scan(it, &s[i], len - i);
+        }
+    }
+}
+
+static uint32_t strngr_split_step(strngr_split_iter_t *it, str_view_t *token)
+{
+    while (it->done == 0U)
+    {
+        const uint32_t start = it->pos;
+        const uint32_t end   = strngr_split_find(it, start);
+
+        if (end >= it->src.len)
+        {
+            it->done = 1U;
+            it->pos  = it->src.len;
+        }
+        else
+        {
+            it->pos = end + ((it->mode == STRNGR_SPLIT_MODE_STRING) ? it->sep.len : 1U);
+        }
+
+        if (((it->flags & STRNGR_SPLIT_SKIP_EMPTY) == 0U) || (end != start))
+        {
+            token->str = &it->src.str[start];
+            token->len = end - start;
+            return 1U;
+        }
+    }
+
+    return 0U;
+}
+
+STRNGR_API void *strngr_arena_alloc(strngr_arena_t *arena, const uint32_t size, const uint32_t align)
+{
+    if ((arena == NULL) || (arena->mem == NULL))
+    {
+        return NULL;
+    }
+
+    /* Alignment must be a power of two; zero means unaligned */
+    const uint32_t a = (align == 0U) ? 1U : align;
+    if ((a & (a - 1U)) != 0U)
+    {
+        return NULL;
+    }
+
+    /* Align the absolute address, not the offset, so the caller's block alignment does not matter */
+    const uintptr_t top = (uintptr_t)&arena->mem[arena->used];
+    const uint32_t  pad = (uint32_t)((a - (top & (uintptr_t)(a - 1U))) & (uintptr_t)(a - 1U));
+    const uint32_t  room = arena->size - arena->used;
+    if ((pad > room) || (size > (room - pad)))
+    {
+        return NULL;
+    }
+
+    void *result = (void *)&arena->mem[arena->used + pad];
+    arena->used += pad + size;
+
+    return result;
+}
+
+STRNGR_API strngr_arena_t *strngr_arena_init(strngr_arena_t *arena, void *mem, const uint32_t mem_len,
+                                             const uint32_t flags)
+{
+    if ((arena == NULL) || (mem == NULL))
+    {
+        return NULL;
+    }
+
+    arena->mem   = (char *)mem;
+    arena->size  = mem_len;
+    arena->used  = 0U;
+    arena->flags = flags;
+
+    return arena;
+}
+
+STRNGR_API uint32_t strngr_arena_mark(const strngr_arena_t *arena)
+{
+    if (arena == NULL)
+    {
+        return 0U;
+    }
+
+    return arena->used;
+}
+
+STRNGR_API str_t strngr_arena_new(strngr_arena_t *arena, const uint32_t max_len)
+{
+    str_t result = {0U, 0U, NULL, 0U};
+
+    if ((arena == NULL) || (max_len == 0U))
+    {
+        return result;
+    }
+
+    char *mem = (char *)strngr_arena_alloc(arena, max_len, 1U);
+    if (mem != NULL)
+    {
+        (void)strngr_new_ex(&result, mem, max_len, arena->flags);
+    }
+
+    return result;
+}
+
+STRNGR_API str_t strngr_arena_new_s(strngr_arena_t *arena, const char *string)
+{
+    str_t result = {0U, 0U, NULL, 0U};
+
+    if ((arena == NULL) || (arena->mem == NULL) || (string == NULL))
+    {
+        return result;
+    }
+
+    /* Ingest into whatever is left, then give back everything past the string (and its terminator) */
+    const uint32_t start     = arena->used;
+    uint32_t       truncated = 0U;
+
+    result = strngr_new_s_trunc(&arena->mem[start], arena->size - start, string, arena->flags | STRNGR_FLAG_NO_SCRUB,
+                                &truncated);
+    if ((result.str == NULL) || (truncated != 0U))
+    {
+        result.str     = NULL;
+        result.len     = 0U;
+        result.max_len = 0U;
+        result.term    = 0U;
+        return result;
+    }
+
+    result.max_len = result.len + (((arena->flags & STRNGR_FLAG_TERMINATED) != 0U) ? 1U : 0U);
+    result.term    = arena->flags;
+    arena->used    = start + result.max_len;
+
+    return result;
+}
+
+STRNGR_API void strngr_arena_reset(strngr_arena_t *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    arena->used = 0U;
+}
+
+STRNGR_API void strngr_arena_rewind(strngr_arena_t *arena, const uint32_t mark)
+{
+    if ((arena == NULL) || (mark > arena->used))
+    {
+        return;
+    }
+
+    arena->used = mark;
+}
+
+STRNGR_API void strngr_arena_strcat(strngr_arena_t *arena, str_t *dst, const str_t src)
+{
+    if ((arena == NULL) || (arena->mem == NULL) || (dst == NULL) || (dst->str == NULL) || (src.str == NULL))
+    {
+        return;
+    }
+
+    const uint32_t reserve = ((dst->term & STRNGR_FLAG_TERMINATED) != 0U) ? 1U : 0U;
+    const uint64_t total   = (uint64_t)dst->len + (uint64_t)src.len + (uint64_t)reserve;
+    if (total > (uint64_t)UINT32_MAX)
+    {
+        return;
+    }
+    const uint32_t need = (uint32_t)total;
+
+    if (need > dst->max_len)
+    {
+        /* The most recent allocation can grow in place; anything else moves to the top of the arena */
+        if (&dst->str[dst->max_len] == &arena->mem[arena->used])
+        {
+            if ((need - dst->max_len) > (arena->size - arena->used))
+            {
+                return;
+            }
+            arena->used += need - dst->max_len;
+        }
+        else
+        {
+            char *mem = (char *)strngr_arena_alloc(arena, need, 1U);
+            if (mem == NULL)
+            {
+                return;
+            }
+            memcpy((void *)mem, (const void *)dst->str, (size_t)dst->len);
+            dst->str = mem;
+        }
+        dst->max_len = need;
+    }
+
+    strngr_strncat(dst, src, src.len);
+}
+
+STRNGR_API str_t strngr_arena_strsub(strngr_arena_t *arena, const str_t src, const int32_t start, const int32_t end)
+{
+    str_t result = {0U, 0U, NULL, 0U};
+
+    if (arena == NULL)
+    {
+        return result;
+    }
+
+    const str_t sub = strngr_strsub(src, start, end);
+    if (sub.str == NULL)
+    {
+        return result;
+    }
+
+    const uint32_t reserve = ((arena->flags & STRNGR_FLAG_TERMINATED) != 0U) ? 1U : 0U;
+    if ((sub.len + reserve) < sub.len)
+    {
+        return result;
+    }
+
+    char *mem = (char *)strngr_arena_alloc(arena, sub.len + reserve, 1U);
+    if (mem == NULL)
+    {
+        return result;
+    }
+
+    result.str     = mem;
+    result.max_len = sub.len + reserve;
+    result.term    = arena->flags;
+    strngr_strcpy(sub, &result);
+
+    return result;
+}
+
+STRNGR_API strngr_byteset_t *strngr_byteset_compile(strngr_byteset_t *set, const str_t members)
+{
+    if ((set == NULL) || (members.str == NULL))
+    {
+        return NULL;
+    }
+
+    memset((void *)set, 0, sizeof(*set));
+
+    /* Low-nibble pattern of the members in each high-nibble row */
+    uint32_t rows[16] = {0U};
+    for (uint32_t i = 0U; i < members.len; i++)
+    {
+        const uint8_t b = (uint8_t)members.str[i];
+        if (STRNGR_SET_HAS(set->bits, b) == 0U)
+        {
+            set->bits[b >> 5U] |= 1UL << (b & 31U);
+            rows[b >> 4U] |= 1UL << (b & 15U);
+            if (set->count < 4U)
+            {
+                set->any[set->count] = b;
+            }
+            set->count++;
+        }
+    }
+
+    /* Up to four members are compared directly; unused lanes repeat the first one */
+    for (uint32_t i = set->count; (i < 4U) && (set->count != 0U); i++)
+    {
+        set->any[i] = set->any[0];
+    }
+
+    /* Rows with the same pattern share one of eight buckets, so hi[] names the bucket and lo[] lists the buckets
+     * each low nibble is in. Typical delimiter and character-class sets need two to five buckets. */
+    uint32_t buckets[8];
+    uint32_t used = 0U;
+    for (uint32_t h = 0U; h < 16U; h++)
+    {
+        if (rows[h] == 0U)
+        {
+            continue;
+        }
+
+        uint32_t k = 0U;
+        while ((k < used) && (buckets[k] != rows[h]))
+        {
+            k++;
+        }
+        if (k == used)
+        {
+            if (used == 8U)
+            {
+                /* Too many distinct rows: leave it to the bitmap */
+                memset((void *)set->lo, 0, sizeof(set->lo));
+                memset((void *)set->hi, 0, sizeof(set->hi));
+                return set;
+            }
+            buckets[used] = rows[h];
+            used++;
+        }
+        set->hi[h] = (uint8_t)(1U << k);
+    }
+
+    for (uint32_t k = 0U; k < used; k++)
+    {
+        for (uint32_t l = 0U; l < 16U; l++)
+        {
+            if (((buckets[k] >> l) & 1U) != 0U)
+            {
+                set->lo[l] |= (uint8_t)(1U << k);
+            }
+        }
+    }
+    set->nibble = 1U;
+
+    return set;
+}
+
+STRNGR_API void strngr_collapse_ws(str_t *str, const strngr_byteset_t *set)
+{
+    if ((str == NULL) || (str->str == NULL))
+    {
+        return;
+    }
+
+    str->len = strngr_collapse_bytes(str->str, str->len, (set != NULL) ? set : &strngr_ws_set);
+    if ((str->term & STRNGR_FLAG_TERMINATED) != 0U)
+    {
+        str->str[str->len] = '\0';
+    }
+}
+
+STRNGR_API uint32_t strngr_count(const str_t hay, const str_t needle, const uint32_t mode)
+{
+    return strngr_view_count(strngr_view(&hay), strngr_view(&needle), mode);
+}
+
+STRNGR_API uint32_t strngr_count_lines(const str_t src)
+{
+    return strngr_view_count_lines(strngr_view(&src));
+}
+
+STRNGR_API const char *strngr_cstr(const str_t src)
+{
+    /* Only terminated mode keeps str[len] at NUL; elsewhere that byte may be stale or overwritten by an append */
+    if ((src.str == NULL) || ((src.term & STRNGR_FLAG_TERMINATED) == 0U))
+    {
+        return NULL;
+    }
+
+    return src.str;
+}
+
+STRNGR_API uint32_t strngr_equal(const str_t a, const str_t b)
+{
+    return strngr_view_equal(strngr_view(&a), strngr_view(&b));
+}
+
+STRNGR_API uint32_t strngr_equal_nocase(const str_t a, const str_t b)
+{
+    return strngr_view_equal_nocase(strngr_view(&a), strngr_view(&b));
+}
+
+STRNGR_API uint32_t strngr_find_all(const str_t hay, const str_t needle, uint32_t *out_offsets, const uint32_t cap,
+                                    const uint32_t mode)
+{
+    return strngr_view_find_all(strngr_view(&hay), strngr_view(&needle), out_offsets, cap, mode);
+}
+
+STRNGR_API uint32_t strngr_find_all_compiled(const str_t hay, const strngr_needle_t *needle, uint32_t *out_offsets,
+                                             const uint32_t cap, const uint32_t mode)
+{
+    return strngr_view_find_all_compiled(strngr_view(&hay), needle, out_offsets, cap, mode);
+}
+
+STRNGR_API uint64_t strngr_hash(const str_t src)
+{
+    return strngr_view_hash(strngr_view(&src), 0U);
+}
+
+STRNGR_API uint64_t strngr_hash_nocase(const str_t src)
+{
+    return strngr_view_hash_nocase(strngr_view(&src), 0U);
+}
+
+STRNGR_API uint64_t strngr_hash_seeded(const str_t src, const uint64_t seed)
+{
+    return strngr_view_hash(strngr_view(&src), seed);
+}
+
+STRNGR_API str_view_t strngr_intern(strngr_intern_t *pool, const str_t src)
+{
+    return strngr_view_intern(pool, strngr_view(&src));
+}
+
+STRNGR_API str_view_t strngr_intern_find(const strngr_intern_t *pool, const str_t src)
+{
+    return strngr_view_intern_find(pool, strngr_view(&src));
+}
+
+STRNGR_API strngr_intern_t *strngr_intern_init(strngr_intern_t *pool, strngr_arena_t *arena, const uint32_t capacity,
+                                               const uint64_t seed)
+{
+    if ((pool == NULL) || (arena == NULL))
+    {
+        return NULL;
+    }
+
+    const uint32_t slots = strngr_table_slots(capacity, (uint32_t)sizeof(void *));
+    if (slots == 0U)
+    {
+        return NULL;
+    }
+
+    const void **table = (const void **)strngr_arena_alloc(arena, slots * (uint32_t)sizeof(void *),
+                                                             (uint32_t)sizeof(void *));
+    if (table == NULL)
+    {
+        return NULL;
+    }
+
+    for (uint32_t i = 0U; i < slots; i++)
+    {
+        table[i] = NULL;
+    }
+    pool->slots    = table;
+    pool->arena    = arena;
+    pool->seed     = seed;
+    pool->capacity = slots;
+    pool->count    = 0U;
+    pool->lock     = 0U;
+
+    return pool;
+}
+
+STRNGR_API uint32_t strngr_intern_mem_required(const uint32_t capacity)
+{
+    const uint32_t slots = strngr_table_slots(capacity, (uint32_t)sizeof(void *));
+    if (slots == 0U)
+    {
+        return 0U;
+    }
+
+    /* Slot table only; each distinct string then takes a 16-byte header, its bytes and a NUL */
+    return (slots * (uint32_t)sizeof(void *)) + (uint32_t)sizeof(void *);
+}
+
+STRNGR_API strngr_lines_t *strngr_lines_init(strngr_lines_t *it, const str_t src, const uint32_t flags)
+{
+    return strngr_view_lines_init(it, strngr_view(&src), flags);
+}
+
+STRNGR_API uint32_t strngr_lines_next(strngr_lines_t *it, str_view_t *line)
+{
+    if ((it == NULL) || (line == NULL) || (it->src.str == NULL))
+    {
+        return 0U;
+    }
+
+    if (it->head == it->count)
+    {
+        strngr_lines_fill(it);
+    }
+
+    const uint32_t start = it->pos;
+    uint32_t       end   = 0U;
+    if (it->head < it->count)
+    {
+        end = it->nl[it->head];
+        it->head++;
+        it->pos = end + 1U;
+    }
+    else if (start < it->src.len)
+    {
+        /* Final line without a newline */
+        end     = it->src.len;
+        it->pos = end;
+    }
+    else
+    {
+        return 0U;
+    }
+
+    line->str = &it->src.str[start];
+    line->len = end - start;
+    if (((it->flags & STRNGR_LINES_STRIP_CR) != 0U) && (line->len != 0U) && (end < it->src.len) &&
+        (line->str[line->len - 1U] == '\r'))
+    {
+        line->len--;
+    }
+
+    return 1U;
+}
+
+STRNGR_API str_t strngr_ltrim(const str_t src, const strngr_byteset_t *set)
+{
+    return strngr_trim_str(src, set, STRNGR_TRIM_LEFT);
+}
+
+STRNGR_API uint64_t *strngr_map_find(const strngr_map_t *map, const str_t key)
+{
+    return strngr_view_map_find(map, strngr_view(&key));
+}
+
+STRNGR_API strngr_map_t *strngr_map_init(strngr_map_t *map, strngr_arena_t *arena, const uint32_t capacity,
+                                         const uint64_t seed)
+{
+    if ((map == NULL) || (arena == NULL))
+    {
+        return NULL;
+    }
+
+    const uint32_t slots = strngr_table_slots(capacity, STRNGR_MAP_SLOT_SIZE);
+    if (slots == 0U)
+    {
+        return NULL;
+    }
+
+    const uint32_t mark = strngr_arena_mark(arena);
+    uint8_t       *ctrl = (uint8_t *)strngr_arena_alloc(arena, slots, STRNGR_MAP_GROUP);
+    void          *entries = strngr_arena_alloc(arena, slots * (uint32_t)sizeof(strngr_map_entry_t), 8U);
+    if ((ctrl == NULL) || (entries == NULL))
+    {
+        strngr_arena_rewind(arena, mark);
+        return NULL;
+    }
+
+    memset((void *)ctrl, (int)STRNGR_MAP_EMPTY, (size_t)slots);
+    map->ctrl     = ctrl;
+    map->entries  = (strngr_map_entry_t *)entries;
+    map->arena    = arena;
+    map->seed     = seed;
+    map->capacity = slots;
+    map->count    = 0U;
+    map->used     = 0U;
+
+    return map;
+}
+
+STRNGR_API uint32_t strngr_map_mem_required(const uint32_t capacity)
+{
+    const uint32_t slots = strngr_table_slots(capacity, STRNGR_MAP_SLOT_SIZE);
+    if (slots == 0U)
+    {
+        return 0U;
+    }
+
+    /* Table only; key bytes are copied into the same arena as they are inserted */
+    return slots + (slots * (uint32_t)sizeof(strngr_map_entry_t)) + STRNGR_MAP_GROUP + 8U;
+}
+
+STRNGR_API uint64_t *strngr_map_put(strngr_map_t *map, const str_t key, const uint64_t value)
+{
+    if ((map == NULL) || (map->ctrl == NULL) || (key.str == NULL))
+    {
+        return NULL;
+    }
+
+    const str_view_t k    = strngr_view(&key);
+    const uint64_t   hash = strngr_view_hash(k, map->seed);
+
+    uint32_t slot = strngr_map_probe(map, k, hash);
+    if (slot != STRNGR_MAP_NONE)
+    {
+        map->entries[slot].value = value;
+        return &map->entries[slot].value;
+    }
+
+    /* Reusing a tombstone is always allowed; taking an EMPTY slot counts against the 7/8 fill limit */
+    slot = strngr_map_probe_free(map, hash);
+    if (slot == STRNGR_MAP_NONE)
+    {
+        return NULL;
+    }
+    const uint32_t fresh = (map->ctrl[slot] == (uint8_t)STRNGR_MAP_EMPTY) ? 1U : 0U;
+    if ((fresh != 0U) && (map->used >= (map->capacity - (map->capacity / 8U))))
+    {
+        return NULL;
+    }
+
+    char *mem = (char *)strngr_arena_alloc(map->arena, k.len, 1U);
+    if (mem == NULL)
+    {
+        return NULL;
+    }
+    memcpy((void *)mem, (const void *)k.str, (size_t)k.len);
+
+    strngr_map_entry_t *entry = &map->entries[slot];
+    entry->key.str            = mem;
+    entry->key.len            = k.len;
+    entry->hash               = hash;
+    entry->value              = value;
+    map->ctrl[slot]           = (uint8_t)(hash & 0x7FU);
+    map->count++;
+    map->used += fresh;
+
+    return &entry->value;
+}
+
+STRNGR_API uint32_t strngr_map_remove(strngr_map_t *map, const str_t key)
+{
+    if ((map == NULL) || (map->ctrl == NULL) || (key.str == NULL))
+    {
+        return 0U;
+    }
+
+    const str_view_t k    = strngr_view(&key);
+    const uint32_t   slot = strngr_map_probe(map, k, strngr_view_hash(k, map->seed));
+    if (slot == STRNGR_MAP_NONE)
+    {
+        return 0U;
+    }
+
+    /* A group that still has an EMPTY slot ends every probe that reaches it, so nothing can sit behind it and
+     * the slot may go straight back to EMPTY. Otherwise leave a tombstone. The key bytes stay in the arena. */
+    uint8_t *group = &map->ctrl[slot - (slot % STRNGR_MAP_GROUP)];
+    if (strngr_map_match(group, (uint8_t)STRNGR_MAP_EMPTY) != 0U)
+    {
+        map->ctrl[slot] = (uint8_t)STRNGR_MAP_EMPTY;
+        map->used--;
+    }
+    else
+    {
+        map->ctrl[slot] = (uint8_t)STRNGR_MAP_DELETED;
+    }
+    map->count--;
+
+    return 1U;
+}
+
+STRNGR_API strngr_multi_t *strngr_multi_compile(strngr_multi_t *multi, const str_t *patterns, const uint32_t count,
+                                                void *mem, const uint32_t mem_len)
+{
+    if ((multi == NULL) || (patterns == NULL) || (count == 0U))
+    {
+        return NULL;
+    }
+
+    multi->patterns = patterns;
+    multi->count    = count;
+    multi->trans    = NULL;
+    multi->out      = NULL;
+    multi->dict     = NULL;
+    multi->next     = NULL;
+    multi->depth    = NULL;
+    multi->pending  = 0U;
+
+#if defined(STRNGR_SSSE3)
+    if (count <= STRNGR_MULTI_TEDDY_MAX)
+    {
+        return strngr_multi_build_teddy(multi);
+    }
+#endif
+
+    if (mem == NULL)
+    {
+        return NULL;
+    }
+
+    return strngr_multi_build_dfa(multi, mem, mem_len);
+}
+
+STRNGR_API uint32_t strngr_multi_find_all(const strngr_multi_t *multi, const str_t hay, strngr_match_t *out,
+                                          const uint32_t cap)
+{
+    return strngr_view_multi_find_all(multi, strngr_view(&hay), out, cap);
+}
+
+STRNGR_API uint32_t strngr_multi_mem_required(const str_t *patterns, const uint32_t count)
+{
+    uint32_t states  = 0U;
+    uint32_t classes = 0U;
+
+    if ((patterns == NULL) || (count == 0U))
+    {
+        return 0U;
+    }
+
+    return strngr_multi_dfa_size(patterns, count, &states, &classes);
+}
+
+STRNGR_API uint32_t strngr_multi_scan(const strngr_multi_t *multi, const str_t hay, strngr_match_cb_t fn, void *ctx)
+{
+    return strngr_view_multi_scan(multi, strngr_view(&hay), fn, ctx);
+}
+
+STRNGR_API strngr_needle_t *strngr_needle_compile(strngr_needle_t *needle, const str_t pattern)
+{
+    if ((needle == NULL) || (pattern.str == NULL))
+    {
+        return NULL;
+    }
+
+    const uint8_t *p = (const uint8_t *)pattern.str;
+
+    needle->pattern = pattern;
+    needle->rare1   = 0U;
+    needle->rare2   = 0U;
+
+    if (pattern.len < 2U)
+    {
+        return needle;
+    }
+
+    /* Filter on the rarest byte, then the rarest other offset, preferring a different byte value */
+    uint32_t rare1 = 0U;
+    for (uint32_t i = 1U; i < pattern.len; i++)
+    {
+        if (strngr_byte_rank[p[i]] < strngr_byte_rank[p[rare1]])
+        {
+            rare1 = i;
+        }
+    }
+
+    uint32_t rare2      = (rare1 == 0U) ? 1U : 0U;
+    uint32_t rare2_cost = UINT32_MAX;
+    for (uint32_t i = 0U; i < pattern.len; i++)
+    {
+        uint32_t cost = strngr_byte_rank[p[i]];
+        if (p[i] == p[rare1])
+        {
+            cost += 256U;
+        }
+        if ((i != rare1) && (cost < rare2_cost))
+        {
+            rare2      = i;
+            rare2_cost = cost;
+        }
+    }
+
+    needle->rare1 = rare1;
+    needle->rare2 = rare2;
+
+    strngr_twoway_prepare(&needle->tw, pattern.str, pattern.len);
+
+    return needle;
+}
+
+STRNGR_API char *strngr_new(str_t *str, char *mem, const uint32_t mem_len)
+{
+    return strngr_new_ex(str, mem, mem_len, STRNGR_DEFAULT_FLAGS);
+}
+
+STRNGR_API char *strngr_new_ex(str_t *str, char *mem, const uint32_t mem_len, const uint32_t flags)
+{
+    if ((str == NULL) || (mem == NULL))
+    {
+        return NULL;
+    }
+
+    if (mem_len == 0U)
+    {
+        return NULL;
+    }
+
+    str->len     = 0U;
+    str->max_len = mem_len;
+    str->str     = mem;
+    str->term    = flags;
+
+    /* Every operation is length-bounded, so scrubbing is only needed for callers that read past len */
+    if ((flags & STRNGR_FLAG_NO_SCRUB) == 0U)
+    {
+        memset((void *)str->str, 0U, str->max_len);
+    }
+    else if ((flags & STRNGR_FLAG_TERMINATED) != 0U)
+    {
+        str->str[0] = '\0';
+    }
+    else
+    {
+        /* Length-only string */
+    }
+
+    return str->str;
+}
+
+STRNGR_API str_t strngr_new_s(char *mem, const uint32_t mem_len, const char *string)
+{
+    return strngr_new_s_ex(mem, mem_len, string, STRNGR_DEFAULT_FLAGS);
+}
+
+STRNGR_API uint32_t strngr_new_s_bulk(str_t *out, const char *const *strings, const uint32_t count, char *mem,
+                                      const uint32_t mem_len, const uint32_t flags)
+{
+    uint32_t used = 0U;
+    uint32_t done = 0U;
+
+    if ((out == NULL) || (strings == NULL) || (mem == NULL))
+    {
+        return 0U;
+    }
+
+    for (; done < count; done++)
+    {
+        if (strings[done] == NULL)
+        {
+            break;
+        }
+
+        /* An empty string takes no room unless it carries a terminator, so a full buffer still accepts it */
+        if ((strings[done][0] == '\0') && ((flags & STRNGR_FLAG_TERMINATED) == 0U))
+        {
+            const str_t empty = {0U, 0U, &mem[used], flags};
+            out[done]         = empty;
+            continue;
+        }
+
+        /* Each string takes exactly the room it needs, packed back to back, so nothing is left to scrub */
+        uint32_t truncated = 0U;
+        str_t    str = strngr_new_s_trunc(&mem[used], mem_len - used, strings[done], flags | STRNGR_FLAG_NO_SCRUB,
+                                          &truncated);
+        if ((str.str == NULL) || (truncated != 0U))
+        {
+            break;
+        }
+
+        str.max_len = str.len + (((flags & STRNGR_FLAG_TERMINATED) != 0U) ? 1U : 0U);
+        str.term    = flags;
+
+        out[done] = str;
+        used += str.max_len;
+    }
+
+    return done;
+}
+
+STRNGR_API str_t strngr_new_s_ex(char *mem, const uint32_t mem_len, const char *string, const uint32_t flags)
+{
+    return strngr_new_s_trunc(mem, mem_len, string, flags, NULL);
+}
+
+STRNGR_API str_t strngr_new_s_trunc(char *mem, const uint32_t mem_len, const char *string, const uint32_t flags,
+                                    uint32_t *truncated)
+{
+    str_t result = {0U, 0U, NULL, 0U};
+
+    if (truncated != NULL)
+    {
+        *truncated = 0U;
+    }
+
+    if ((mem == NULL) || (string == NULL))
+    {
+        return result;
+    }
+
+    if (mem_len == 0U)
+    {
+        return result;
+    }
+
+    result.max_len = mem_len;
+    result.str     = mem;
+    result.term    = flags;
+
+    /* Read the source only as far as the buffer can hold, so a long source costs the destination's capacity
+     * rather than its own length */
+    const uint32_t cpy_len = strngr_cstr_copy(result.str, string, strngr_capacity(&result), truncated);
+
+    /* Only the tail beyond the copied data needs scrubbing */
+    if ((flags & STRNGR_FLAG_NO_SCRUB) == 0U)
+    {
+        memset((void *)&result.str[cpy_len], 0U, (size_t)(result.max_len - cpy_len));
+    }
+    if ((flags & STRNGR_FLAG_TERMINATED) != 0U)
+    {
+        result.str[cpy_len] = '\0';
+    }
+
+    /* Set the length to match the copied data */
+    result.len = cpy_len;
+
+    return result;
+}
+
+STRNGR_API str_t strngr_rtrim(const str_t src, const strngr_byteset_t *set)
+{
+    return strngr_trim_str(src, set, STRNGR_TRIM_RIGHT);
+}
+
+STRNGR_API void strngr_reset_to_empty(str_t *str)
+{
+    if ((str == NULL) || (str->str == NULL))
+    {
+        return;
+    }
+
+    /* Strings created with STRNGR_FLAG_NO_SCRUB only drop their length */
+    if ((str->term & STRNGR_FLAG_NO_SCRUB) == 0U)
+    {
+        memset((void *)str->str, 0U, str->max_len);
+    }
+    else if (((str->term & STRNGR_FLAG_TERMINATED) != 0U) && (str->max_len != 0U))
+    {
+        str->str[0] = '\0';
+    }
+    else
+    {
+        /* Length-only string */
+    }
+
+    str->len = 0U;
+}
+
+STRNGR_API uint32_t strngr_split_all(strngr_split_iter_t *it, str_view_t *out, const uint32_t cap)
+{
+    uint32_t n = 0U;
+
+    if ((it == NULL) || (out == NULL))
+    {
+        return 0U;
+    }
+
+    /* Stops at cap; the iterator is left on the next token so the caller can continue */
+    while ((n < cap) && (strngr_split_step(it, &out[n]) != 0U))
+    {
+        n++;
+    }
+
+    return n;
+}
+
+STRNGR_API strngr_split_iter_t *strngr_split_init(strngr_split_iter_t *it, const str_t src, const str_t sep,
+                                                  const uint32_t flags)
+{
+    return strngr_view_split_init(it, strngr_view(&src), strngr_view(&sep), flags);
+}
+
+STRNGR_API strngr_split_iter_t *strngr_split_init_set(strngr_split_iter_t *it, const str_t src, const str_t set,
+                                                      const uint32_t flags)
+{
+    return strngr_view_split_init_set(it, strngr_view(&src), strngr_view(&set), flags);
+}
+
+STRNGR_API uint32_t strngr_split_next(strngr_split_iter_t *it, str_view_t *token)
+{
+    if ((it == NULL) || (token == NULL))
+    {
+        return 0U;
+    }
+
+    return strngr_split_step(it, token);
+}
+
+STRNGR_API uint32_t strngr_stream_feed(strngr_stream_t *st, const str_t chunk, strngr_stream_cb_t fn, void *ctx)
+{
+    return strngr_view_stream_feed(st, strngr_view(&chunk), fn, ctx);
+}
+
+STRNGR_API strngr_stream_t *strngr_stream_init(strngr_stream_t *st, const strngr_needle_t *needle, char *mem,
+                                               const uint32_t mem_len)
+{
+    if ((st == NULL) || (needle == NULL) || (needle->pattern.str == NULL) || (needle->pattern.len == 0U))
+    {
+        return NULL;
+    }
+
+    /* A needle too long to carry between chunks has no memory size, and must not pass as needing none */
+    const uint32_t keep = needle->pattern.len - 1U;
+    const uint32_t need = strngr_stream_mem_required(needle->pattern.len);
+    if (((keep != 0U) && (need == 0U)) || (need > mem_len) || ((need != 0U) && (mem == NULL)))
+    {
+        return NULL;
+    }
+
+    st->needle   = needle;
+    st->multi    = NULL;
+    st->mem      = mem;
+    st->keep     = keep;
+    st->carry    = 0U;
+    st->consumed = 0U;
+    st->stopped  = 0U;
+
+    return st;
+}
+
+STRNGR_API strngr_stream_t *strngr_stream_init_multi(strngr_stream_t *st, const strngr_multi_t *multi, char *mem,
+                                                     const uint32_t mem_len)
+{
+    if ((st == NULL) || (multi == NULL) || (multi->patterns == NULL) || (multi->count == 0U))
+    {
+        return NULL;
+    }
+
+    uint32_t longest = 0U;
+    for (uint32_t p = 0U; p < multi->count; p++)
+    {
+        longest = (multi->patterns[p].len > longest) ? multi->patterns[p].len : longest;
+    }
+
+    const uint32_t need = strngr_stream_mem_required(longest);
+    if ((longest == 0U) || ((longest > 1U) && (need == 0U)) || (need > mem_len) || ((need != 0U) && (mem == NULL)))
+    {
+        return NULL;
+    }
+
+    st->needle   = NULL;
+    st->multi    = multi;
+    st->mem      = mem;
+    st->keep     = longest - 1U;
+    st->carry    = 0U;
+    st->consumed = 0U;
+    st->stopped  = 0U;
+
+    return st;
+}
+
+STRNGR_API uint32_t strngr_stream_mem_required(const uint32_t max_needle_len)
+{
+    /* The carried tail plus room to append the same number of bytes from the next chunk */
+    if ((max_needle_len <= 1U) || (max_needle_len > (UINT32_MAX / 2U)))
+    {
+        return 0U;
+    }
+
+    return 2U * (max_needle_len - 1U);
+}
+
+STRNGR_API void strngr_strcat(str_t *dst, const str_t src)
+{
+    if ((dst->str == NULL) || (src.str == NULL))
+    {
+        return;
+    }
+
+    /* Check for space in the destination */
+    if (strngr_capacity(dst) < (dst->len + src.len))
+    {
+        return;
+    }
+
+    strngr_strncat(dst, src, (const uint32_t)src.len);
+}
+
+STRNGR_API str_t strngr_strcasestr(const str_t hay, const str_t needle)
+{
+    str_t            result = {0U, 0U, NULL, 0U};
+    const str_view_t found  = strngr_view_strcasestr(strngr_view(&hay), strngr_view(&needle));
+
+    if (found.str == NULL)
+    {
+        return result;
+    }
+
+    return strngr_view_from(hay, (uint32_t)(found.str - hay.str));
+}
+
+STRNGR_API char *strngr_strchr(const str_t src, const char matcher)
+{
+    if (src.str == NULL)
+    {
+        return NULL;
+    }
+
+    uint32_t pos = strngr_strcspn(src, matcher);
+
+    /* By defintion of the strcspn behaviour, the string length is returned if nothing is found */
+    if (pos >= src.len)
+    {
+        return NULL;
+    }
+
+    return &src.str[pos];
+}
+
+STRNGR_API void strngr_strcpy(const str_t src, str_t *dst)
 {
-    if ((str == NULL) || (mem == NULL))
+    if ((src.str == NULL) || (dst->str == NULL))
+    {
+        return;
+    }
+
+    uint32_t l = src.len;
+    if (l > strngr_capacity(dst))
+    {
+        l = strngr_capacity(dst);
+    }
+
+    strngr_strncpy(src, dst, l);
+}
+
+STRNGR_API uint32_t strngr_strcspn(const str_t src, const char matcher)
+{
+    return strngr_view_strcspn(strngr_view(&src), matcher);
+}
+
+STRNGR_API uint32_t strngr_strcspn_set(const str_t src, const strngr_byteset_t *set)
+{
+    return strngr_view_strcspn_set(strngr_view(&src), set);
+}
+
+STRNGR_API uint32_t strngr_strlen(const str_t src)
+{
+    if (src.str == NULL)
+    {
+        return 0U;
+    }
+
+    return src.len;
+}
+
+STRNGR_API void strngr_strncat(str_t *dst, const str_t src, uint32_t n)
+{
+    if ((dst->str == NULL) || (src.str == NULL))
+    {
+        return;
+    }
+
+    if (n > src.len)
+    {
+        n = src.len;
+    }
+
+    /* Check for space in the destination */
+    if (strngr_capacity(dst) < (dst->len + n))
+    {
+        return;
+    }
+
+    /* Do the mem copy */
+    memcpy((void *)(dst->str + dst->len), (void *)src.str, (size_t)n);
+
+    /* Update the string length */
+    dst->len = dst->len + n;
+
+    if ((dst->term & STRNGR_FLAG_TERMINATED) != 0U)
+    {
+        dst->str[dst->len] = '\0';
+    }
+}
+
+STRNGR_API int32_t strngr_strncasecmp(const str_t a, const str_t b, uint32_t n)
+{
+    return strngr_view_strncasecmp(strngr_view(&a), strngr_view(&b), n);
+}
+
+STRNGR_API int32_t strngr_strncmp(const str_t a, const str_t b, uint32_t n)
+{
+    return strngr_view_strncmp(strngr_view(&a), strngr_view(&b), n);
+}
+
+STRNGR_API void strngr_strncpy(const str_t src, str_t *dst, uint32_t n)
+{
+    if ((src.str == NULL) || (dst->str == NULL))
+    {
+        return;
+    }
+
+    /* Limit n to available space */
+    if (strngr_capacity(dst) < n)
+    {
+        n = strngr_capacity(dst);
+    }
+
+    /* Determine how many characters to copy */
+    uint32_t copy_len = src.len;
+    if (copy_len > n)
+    {
+        copy_len = n;
+    }
+
+    /* Copy the characters */
+    memcpy((void *)dst->str, (void *)src.str, (size_t)copy_len);
+
+    /* If source is shorter than n, pad with zeros (like standard strncpy) */
+    if (copy_len < n)
+    {
+        memset((void *)(dst->str + copy_len), 0U, (size_t)(n - copy_len));
+    }
+
+    /* Update the length */
+    dst->len = copy_len;
+
+    if ((dst->term & STRNGR_FLAG_TERMINATED) != 0U)
+    {
+        dst->str[copy_len] = '\0';
+    }
+}
+
+STRNGR_API char *strngr_strpbrk(const str_t src, const strngr_byteset_t *set)
+{
+    return (char *)strngr_view_strpbrk(strngr_view(&src), set);
+}
+
+STRNGR_API char *strngr_strrchr(const str_t src, const char matcher)
+{
+    return (char *)strngr_view_strrchr(strngr_view(&src), matcher);
+}
+
+STRNGR_API str_t strngr_strrstr(const str_t hay, const str_t needle)
+{
+    str_t            result = {0U, 0U, NULL, 0U};
+    const str_view_t found  = strngr_view_strrstr(strngr_view(&hay), strngr_view(&needle));
+
+    if (found.str == NULL)
+    {
+        return result;
+    }
+
+    /* Found - return a view from the last match position to end of haystack */
+    return strngr_view_from(hay, (uint32_t)(found.str - hay.str));
+}
+
+STRNGR_API uint32_t strngr_strspn(const str_t src, const strngr_byteset_t *set)
+{
+    return strngr_view_strspn(strngr_view(&src), set);
+}
+
+STRNGR_API str_t strngr_strstr(const str_t hay, const str_t needle)
+{
+    str_t            result = {0U, 0U, NULL, 0U};
+    const str_view_t found  = strngr_view_strstr(strngr_view(&hay), strngr_view(&needle));
+
+    if (found.str == NULL)
+    {
+        return result;
+    }
+
+    /* Found - return a view from the match position to end of haystack */
+    return strngr_view_from(hay, (uint32_t)(found.str - hay.str));
+}
+
+STRNGR_API str_t strngr_strstr_compiled(const str_t hay, const strngr_needle_t *needle)
+{
+    str_t            result = {0U, 0U, NULL, 0U};
+    const str_view_t found  = strngr_view_strstr_compiled(strngr_view(&hay), needle);
+
+    if (found.str == NULL)
+    {
+        return result;
+    }
+
+    return strngr_view_from(hay, (uint32_t)(found.str - hay.str));
+}
+
+STRNGR_API str_t strngr_strsub(const str_t src, const int32_t start, const int32_t end)
+{
+    str_t    result  = {0U, 0U, NULL, 0U};
+    uint32_t off     = 0U;
+    uint32_t sub_len = 0U;
+
+    if (src.str == NULL)
+    {
+        return result;
+    }
+
+    if (strngr_sub_range(src.len, start, end, &off, &sub_len) == 0U)
+    {
+        return result;
+    }
+
+    return strngr_view_at(src, off, sub_len);
+}
+
+STRNGR_API void strngr_to_lower(str_t *str)
+{
+    if ((str == NULL) || (str->str == NULL))
+    {
+        return;
+    }
+
+    strngr_flip_bytes(str->str, str->str, str->len, (uint8_t)'A');
+}
+
+STRNGR_API void strngr_to_lower_cpy(const str_t src, str_t *dst)
+{
+    const uint32_t n = strngr_cpy_len(src, dst);
+    if (n != UINT32_MAX)
+    {
+        strngr_flip_bytes(src.str, dst->str, n, (uint8_t)'A');
+    }
+}
+
+STRNGR_API void strngr_to_upper(str_t *str)
+{
+    if ((str == NULL) || (str->str == NULL))
+    {
+        return;
+    }
+
+    strngr_flip_bytes(str->str, str->str, str->len, (uint8_t)'a');
+}
+
+STRNGR_API void strngr_to_upper_cpy(const str_t src, str_t *dst)
+{
+    const uint32_t n = strngr_cpy_len(src, dst);
+    if (n != UINT32_MAX)
+    {
+        strngr_flip_bytes(src.str, dst->str, n, (uint8_t)'a');
+    }
+}
+
+STRNGR_API strngr_tr_t *strngr_tr_compile(strngr_tr_t *tr, const str_t from, const str_t to)
+{
+    if ((tr == NULL) || (from.str == NULL) || (to.str == NULL) || (to.len == 0U))
+    {
+        return NULL;
+    }
+
+    uint8_t table[256];
+    for (uint32_t b = 0U; b < 256U; b++)
+    {
+        table[b] = (uint8_t)b;
+    }
+
+    /* Like tr(1), a short to is padded with its last byte; if a byte repeats in from, the last mapping wins */
+    for (uint32_t i = 0U; i < from.len; i++)
+    {
+        table[(uint8_t)from.str[i]] = (uint8_t)to.str[(i < to.len) ? i : (to.len - 1U)];
+    }
+
+    return strngr_tr_compile_table(tr, table);
+}
+
+STRNGR_API strngr_tr_t *strngr_tr_compile_table(strngr_tr_t *tr, const uint8_t table[256])
+{
+    if ((tr == NULL) || (table == NULL))
     {
         return NULL;
     }
 
-    if (mem_len == 0U)
+    memcpy((void *)tr->map, (const void *)table, sizeof(tr->map));
+
+    /* Rows (bytes sharing a high nibble) where the table is the identity need no work */
+    tr->rows = 0U;
+    for (uint32_t b = 0U; b < 256U; b++)
+    {
+        if (table[b] != (uint8_t)b)
+        {
+            tr->rows |= 1U << (b >> 4U);
+        }
+    }
+
+    return tr;
+}
+
+STRNGR_API void strngr_translate(str_t *str, const strngr_tr_t *tr)
+{
+    if ((str == NULL) || (str->str == NULL) || (tr == NULL))
+    {
+        return;
+    }
+
+    strngr_tr_bytes(str->str, str->str, str->len, tr);
+}
+
+STRNGR_API void strngr_translate_cpy(const str_t src, str_t *dst, const strngr_tr_t *tr)
+{
+    if (tr == NULL)
+    {
+        return;
+    }
+
+    const uint32_t n = strngr_cpy_len(src, dst);
+    if (n != UINT32_MAX)
+    {
+        strngr_tr_bytes(src.str, dst->str, n, tr);
+    }
+}
+
+STRNGR_API str_t strngr_trim(const str_t src, const strngr_byteset_t *set)
+{
+    return strngr_trim_str(src, set, STRNGR_TRIM_LEFT | STRNGR_TRIM_RIGHT);
+}
+
+STRNGR_API str_view_t strngr_view(const str_t *src)
+{
+    str_view_t result = {NULL, 0U};
+
+    if ((src == NULL) || (src->str == NULL))
+    {
+        return result;
+    }
+
+    result.str = src->str;
+    result.len = src->len;
+
+    return result;
+}
+
+STRNGR_API uint32_t strngr_view_count(const str_view_t hay, const str_view_t needle, const uint32_t mode)
+{
+    return strngr_find_each(hay, needle, NULL, 0U, mode);
+}
+
+STRNGR_API uint32_t strngr_view_count_lines(const str_view_t src)
+{
+    if ((src.str == NULL) || (src.len == 0U))
+    {
+        return 0U;
+    }
+
+    /* A final line without a newline still counts */
+    const uint32_t n = strngr_count_byte(src.str, src.len, '\n');
+    return n + ((src.str[src.len - 1U] != '\n') ? 1U : 0U);
+}
+
+STRNGR_API uint32_t strngr_view_equal(const str_view_t a, const str_view_t b)
+{
+    if ((a.str == NULL) || (b.str == NULL))
+    {
+        return (a.str == b.str) ? 1U : 0U;
+    }
+
+    /* Different lengths can never be equal, so only same-length strings are compared */
+    if (a.len != b.len)
+    {
+        return 0U;
+    }
+
+    if ((a.str == b.str) || (memcmp((const void *)a.str, (const void *)b.str, (size_t)a.len) == 0))
+    {
+        return 1U;
+    }
+
+    return 0U;
+}
+
+STRNGR_API uint32_t strngr_view_equal_nocase(const str_view_t a, const str_view_t b)
+{
+    if ((a.str == NULL) || (b.str == NULL))
+    {
+        return (a.str == b.str) ? 1U : 0U;
+    }
+
+    if (a.len != b.len)
+    {
+        return 0U;
+    }
+
+    return (strngr_mismatch_nocase(a.str, b.str, a.len) == a.len) ? 1U : 0U;
+}
+
+STRNGR_API uint32_t strngr_view_find_all(const str_view_t hay, const str_view_t needle, uint32_t *out_offsets,
+                                         const uint32_t cap, const uint32_t mode)
+{
+    if ((out_offsets == NULL) && (cap != 0U))
+    {
+        return 0U;
+    }
+
+    /* Returns the total number of matches; only the first cap offsets are stored */
+    return strngr_find_each(hay, needle, out_offsets, cap, mode);
+}
+
+STRNGR_API uint32_t strngr_view_find_all_compiled(const str_view_t hay, const strngr_needle_t *needle,
+                                                  uint32_t *out_offsets, const uint32_t cap, const uint32_t mode)
+{
+    if ((hay.str == NULL) || (needle == NULL) || (needle->pattern.str == NULL) || (needle->pattern.len == 0U) ||
+        ((out_offsets == NULL) && (cap != 0U)))
     {
-        return NULL;
+        return 0U;
     }
 
-    str->len     = 0U;
-    str->max_len = mem_len;
-    str->str     = mem;
-    str->term    = 0U;
+    return strngr_needle_each(needle, hay, out_offsets, cap, mode);
+}
 
-    memset((void *)str->str, 0U, str->max_len);
+STRNGR_API uint64_t strngr_view_hash(const str_view_t src, const uint64_t seed)
+{
+    return strngr_hash_bytes(src, seed, 0U);
+}
 
-    return str->str;
+STRNGR_API uint64_t strngr_view_hash_nocase(const str_view_t src, const uint64_t seed)
+{
+    return strngr_hash_bytes(src, seed, 1U);
 }
 
-str_t strngr_new_s(char *mem, const uint32_t mem_len, const char *string)
+STRNGR_API str_view_t strngr_view_intern(strngr_intern_t *pool, const str_view_t src)
 {
-    str_t result = {0U, 0U, NULL, 0U};
+    str_view_t result = {NULL, 0U};
 
-    if ((mem == NULL) || (string == NULL))
+    if ((pool == NULL) || (pool->slots == NULL) || (src.str == NULL))
     {
         return result;
     }
 
-    if (mem_len == 0U)
+    /* Most calls find an existing entry without touching the lock */
+    const uint64_t               hash  = strngr_view_hash(src, pool->seed);
+    uint32_t                     slot  = 0U;
+    const strngr_intern_entry_t *entry = strngr_intern_probe(pool, src, hash, &slot);
+    if (entry != NULL)
+    {
+        return strngr_intern_view(entry);
+    }
+
+    strngr_intern_lock(pool);
+
+    /* Probe again: another writer may have added the string, or taken the empty slot, since the first look */
+    entry = strngr_intern_probe(pool, src, hash, &slot);
+    if ((entry == NULL) && (slot != STRNGR_MAP_NONE) && (pool->count < (pool->capacity - (pool->capacity / 8U))) &&
+        (src.len < (UINT32_MAX - (uint32_t)sizeof(strngr_intern_entry_t))))
+    {
+        strngr_intern_entry_t *fresh = (strngr_intern_entry_t *)strngr_arena_alloc(
+            pool->arena, (uint32_t)sizeof(strngr_intern_entry_t) + src.len + 1U, 8U);
+        if (fresh != NULL)
+        {
+            char *bytes = (char *)&fresh[1];
+            memcpy((void *)bytes, (const void *)src.str, (size_t)src.len);
+            bytes[src.len]  = '\0';
+            fresh->hash     = hash;
+            fresh->len      = src.len;
+            fresh->reserved = 0U;
+
+            /* Publish only once the entry is complete */
+            STRNGR_STORE_RELEASE(&pool->slots[slot], (const void *)fresh);
+            pool->count++;
+            entry = fresh;
+        }
+    }
+
+    STRNGR_UNLOCK(&pool->lock);
+
+    return strngr_intern_view(entry);
+}
+
+STRNGR_API str_view_t strngr_view_intern_find(const strngr_intern_t *pool, const str_view_t src)
+{
+    str_view_t result = {NULL, 0U};
+
+    if ((pool == NULL) || (pool->slots == NULL) || (src.str == NULL))
     {
         return result;
     }
 
-    result.max_len = mem_len;
-    result.str     = mem;
+    uint32_t slot = 0U;
+    return strngr_intern_view(strngr_intern_probe(pool, src, strngr_view_hash(src, pool->seed), &slot));
+}
 
-    /* Get the incoming string length and minimise it */
-    uint32_t cpy_len = (uint32_t)strlen(string);
-    if (cpy_len > result.max_len)
+STRNGR_API strngr_lines_t *strngr_view_lines_init(strngr_lines_t *it, const str_view_t src, const uint32_t flags)
+{
+    if ((it == NULL) || (src.str == NULL))
     {
-        cpy_len = result.max_len;
+        return NULL;
     }
 
-    memset((void *)result.str, 0U, result.max_len);
-    memcpy((void *)result.str, (const void *)string, (size_t)cpy_len);
+    it->src   = src;
+    it->pos   = 0U;
+    it->scan  = 0U;
+    it->flags = flags;
+    it->head  = 0U;
+    it->count = 0U;
 
-    /* Set the length to match the copied data */
-    result.len = cpy_len;
+    return it;
+}
 
-    return result;
+STRNGR_API str_view_t strngr_view_ltrim(const str_view_t src, const strngr_byteset_t *set)
+{
+    return strngr_view_trim_ends(src, set, STRNGR_TRIM_LEFT);
 }
 
-void strngr_reset_to_empty(str_t *str)
+STRNGR_API uint64_t *strngr_view_map_find(const strngr_map_t *map, const str_view_t key)
 {
-    if (str == NULL)
+    if ((map == NULL) || (map->ctrl == NULL) || (key.str == NULL))
     {
-        return;
+        return NULL;
     }
 
-    str->len = 0U;
-    memset((void *)str->str, 0U, str->max_len);
+    const uint32_t slot = strngr_map_probe(map, key, strngr_view_hash(key, map->seed));
+    if (slot == STRNGR_MAP_NONE)
+    {
+        return NULL;
+    }
+
+    return &map->entries[slot].value;
 }
 
-void strngr_strcat(str_t *dst, const str_t src)
+STRNGR_API uint32_t strngr_view_multi_find_all(const strngr_multi_t *multi, const str_view_t hay, strngr_match_t *out,
+                                               const uint32_t cap)
 {
-    if ((dst->str == NULL) || (src.str == NULL))
+    if ((out == NULL) || (cap == 0U))
     {
-        return;
+        return 0U;
     }
 
-    /* Check for space in the destination */
-    if (dst->max_len < (dst->len + src.len))
+    strngr_multi_collect_t collect = {out, cap, 0U};
+    (void)strngr_view_multi_scan(multi, hay, strngr_multi_collect, (void *)&collect);
+
+    return collect.used;
+}
+
+STRNGR_API uint32_t strngr_view_multi_scan(const strngr_multi_t *multi, const str_view_t hay, strngr_match_cb_t fn,
+                                           void *ctx)
+{
+    if ((multi == NULL) || (fn == NULL) || (hay.str == NULL))
     {
-        return;
+        return 0U;
     }
 
-    strngr_strncat(dst, src, (const uint32_t)src.len);
+#if defined(STRNGR_SSSE3)
+    if (multi->engine == STRNGR_MULTI_TEDDY)
+    {
+        return strngr_multi_scan_teddy(multi, hay, fn, ctx);
+    }
+#endif
+
+    if (multi->engine == STRNGR_MULTI_DFA)
+    {
+        return strngr_multi_scan_dfa(multi, hay, fn, ctx);
+    }
+
+    return 0U;
 }
 
-char *strngr_strchr(const str_t src, const char matcher)
+STRNGR_API str_view_t strngr_view_rtrim(const str_view_t src, const strngr_byteset_t *set)
 {
-    if (src.str == NULL)
+    return strngr_view_trim_ends(src, set, STRNGR_TRIM_RIGHT);
+}
+
+STRNGR_API strngr_split_iter_t *strngr_view_split_init(strngr_split_iter_t *it, const str_view_t src,
+                                                       const str_view_t sep, const uint32_t flags)
+{
+    if ((it == NULL) || (src.str == NULL) || (sep.str == NULL) || (sep.len == 0U))
     {
         return NULL;
     }
 
-    uint32_t pos = strngr_strcspn(src, matcher);
+    memset((void *)it, 0, sizeof(*it));
+    it->src   = src;
+    it->sep   = sep;
+    it->flags = flags;
+    it->mode  = (sep.len == 1U) ? STRNGR_SPLIT_MODE_BYTE : STRNGR_SPLIT_MODE_STRING;
+    it->quote = '"';
 
-    /* By defintion of the strcspn behaviour, the string length is returned if nothing is found */
-    if (pos >= src.len)
+    return it;
+}
+
+STRNGR_API strngr_split_iter_t *strngr_view_split_init_set(strngr_split_iter_t *it, const str_view_t src,
+                                                           const str_view_t set, const uint32_t flags)
+{
+    if ((it == NULL) || (src.str == NULL) || (set.str == NULL) || (set.len == 0U))
     {
         return NULL;
     }
 
-    return &src.str[pos];
+    memset((void *)it, 0, sizeof(*it));
+    it->src   = src;
+    it->sep   = set;
+    it->flags = flags;
+    it->mode  = STRNGR_SPLIT_MODE_SET;
+    it->quote = '"';
+
+    const str_t members = {set.len, set.len, (char *)set.str, 0U};
+    (void)strngr_byteset_compile(&it->set, members);
+
+    return it;
 }
 
-void strngr_strcpy(const str_t src, str_t *dst)
+STRNGR_API uint32_t strngr_view_stream_feed(strngr_stream_t *st, const str_view_t chunk, strngr_stream_cb_t fn,
+                                            void *ctx)
 {
-    if ((src.str == NULL) || (dst->str == NULL))
+    if ((st == NULL) || (fn == NULL) || (chunk.str == NULL) || (st->stopped != 0U))
     {
-        return;
+        return 0U;
     }
 
-    uint32_t l = src.len;
-    if (l > dst->max_len)
+    strngr_stream_relay_t relay = {st, fn, ctx, 0U, 0U, 0U};
+    const uint32_t        keep  = st->keep;
+
+    /* Matches straddling the boundary: search the carried tail joined with the head of the new chunk */
+    const uint32_t head = (chunk.len < keep) ? chunk.len : keep;
+    if ((st->carry != 0U) && (head != 0U))
     {
-        l = dst->max_len;
+        memcpy((void *)&st->mem[st->carry], (const void *)chunk.str, (size_t)head);
+        const str_view_t window = {st->mem, st->carry + head};
+        relay.base              = st->consumed - st->carry;
+        relay.window            = 1U;
+        strngr_stream_search(&relay, window);
     }
 
-    strngr_strncpy(src, dst, l);
+    if (st->stopped == 0U)
+    {
+        relay.base   = st->consumed;
+        relay.window = 0U;
+        strngr_stream_search(&relay, chunk);
+    }
+
+    /* Carry the last keep bytes of the stream into the next call */
+    if (keep == 0U)
+    {
+        st->carry = 0U;
+    }
+    else if (chunk.len >= keep)
+    {
+        memcpy((void *)st->mem, (const void *)&chunk.str[chunk.len - keep], (size_t)keep);
+        st->carry = keep;
+    }
+    else
+    {
+        const uint32_t total = st->carry + chunk.len;
+        const uint32_t drop  = (total > keep) ? (total - keep) : 0U;
+        memmove((void *)st->mem, (const void *)&st->mem[drop], (size_t)(st->carry - drop));
+        memcpy((void *)&st->mem[st->carry - drop], (const void *)chunk.str, (size_t)chunk.len);
+        st->carry = total - drop;
+    }
+    st->consumed += chunk.len;
+
+    return relay.found;
 }
 
-uint32_t strngr_strcspn(const str_t src, const char matcher)
+STRNGR_API str_view_t strngr_view_strcasestr(const str_view_t hay, const str_view_t needle)
 {
-    if (src.str == NULL)
+    str_view_t result = {NULL, 0U};
+
+    if ((hay.str == NULL) || (needle.str == NULL))
     {
-        return 0U;
+        return result;
+    }
+
+    if (hay.len < needle.len)
+    {
+        return result;
     }
 
-    for (uint32_t i = 0U; i < src.len; i++)
+    /* An empty needle matches at the start of the haystack */
+    uint32_t i = 0U;
+    if (needle.len != 0U)
     {
-        if (src.str[i] == matcher)
+        i = strngr_find_sub_nocase(hay.str, hay.len, needle.str, needle.len);
+        if (i >= hay.len)
         {
-            return i;
+            return result;
         }
     }
 
-    /* Nothing found so return the length of the input string */
-    return src.len;
+    result.str = &hay.str[i];
+    result.len = hay.len - i;
+
+    return result;
+}
+
+STRNGR_API const char *strngr_view_strchr(const str_view_t src, const char matcher)
+{
+    if (src.str == NULL)
+    {
+        return NULL;
+    }
+
+    const uint32_t pos = strngr_find_byte(src.str, src.len, matcher);
+    if (pos >= src.len)
+    {
+        return NULL;
+    }
+
+    return &src.str[pos];
+}
+
+STRNGR_API uint32_t strngr_view_strcspn(const str_view_t src, const char matcher)
+{
+    if (src.str == NULL)
+    {
+        return 0U;
+    }
+
+    /* Nothing found returns the length of the input string */
+    return strngr_find_byte(src.str, src.len, matcher);
+}
+
+STRNGR_API uint32_t strngr_view_strcspn_set(const str_view_t src, const strngr_byteset_t *set)
+{
+    if ((src.str == NULL) || (set == NULL))
+    {
+        return 0U;
+    }
+
+    /* Nothing found returns the length of the input string */
+    return strngr_find_class(src.str, src.len, set, 1U);
 }
 
-uint32_t strngr_strlen(const str_t src)
+STRNGR_API uint32_t strngr_view_strlen(const str_view_t src)
 {
     if (src.str == NULL)
     {
@@ -149,32 +4662,35 @@ uint32_t strngr_strlen(const str_t src)
     return src.len;
 }
 
-void strngr_strncat(str_t *dst, const str_t src, uint32_t n)
+STRNGR_API int32_t strngr_view_strncasecmp(const str_view_t a, const str_view_t b, uint32_t n)
 {
-    if ((dst->str == NULL) || (src.str == NULL))
+    if ((a.str == NULL) || (b.str == NULL))
     {
-        return;
+        return 0L;
     }
 
-    if (n > src.len)
+    uint32_t min_len = a.len;
+    if (b.len < min_len)
     {
-        n = src.len;
+        min_len = b.len;
     }
 
-    /* Check for space in the destination */
-    if (dst->max_len < (dst->len + n))
+    if (n > min_len)
     {
-        return;
+        n = min_len;
     }
 
-    /* Do the mem copy */
-    memcpy((void *)(dst->str + dst->len), (void *)src.str, (size_t)n);
+    const uint32_t i = strngr_mismatch_nocase(a.str, b.str, n);
+    if (i == n)
+    {
+        return 0L;
+    }
 
-    /* Update the string length */
-    dst->len = dst->len + n;
+    /* Like strncasecmp, the folded (lower-case) bytes are ordered as unsigned char */
+    return (int32_t)strngr_fold_byte((uint8_t)a.str[i]) - (int32_t)strngr_fold_byte((uint8_t)b.str[i]);
 }
 
-int32_t strngr_strncmp(const str_t a, const str_t b, uint32_t n)
+STRNGR_API int32_t strngr_view_strncmp(const str_view_t a, const str_view_t b, uint32_t n)
 {
     if ((a.str == NULL) || (b.str == NULL))
     {
@@ -193,57 +4709,53 @@ int32_t strngr_strncmp(const str_t a, const str_t b, uint32_t n)
         n = min_len;
     }
 
-    /* Compare the characters */
-    for (uint32_t i = 0U; i < n; i++)
-    {
-        int32_t d = (int32_t)a.str[i] - (int32_t)b.str[i];
+    const uint32_t i = strngr_mismatch(a.str, b.str, n);
 
-        if (d != 0L)
-        {
-            return d;
-        }
+    /* All compared characters match - return 0 (standard strncmp behavior) */
+    if (i == n)
+    {
+        return 0L;
     }
 
-    /* All compared characters match - return 0 (standard strncmp behavior) */
-    return 0L;
+    /* Bytes order as unsigned char, like memcmp, whatever the signedness of char */
+    return (int32_t)(uint8_t)a.str[i] - (int32_t)(uint8_t)b.str[i];
 }
 
-void strngr_strncpy(const str_t src, str_t *dst, uint32_t n)
+STRNGR_API const char *strngr_view_strpbrk(const str_view_t src, const strngr_byteset_t *set)
 {
-    if ((src.str == NULL) || (dst->str == NULL))
+    if ((src.str == NULL) || (set == NULL))
     {
-        return;
+        return NULL;
     }
 
-    /* Limit n to available space */
-    if (dst->max_len < n)
+    const uint32_t pos = strngr_find_class(src.str, src.len, set, 1U);
+    if (pos >= src.len)
     {
-        n = dst->max_len;
+        return NULL;
     }
 
-    /* Determine how many characters to copy */
-    uint32_t copy_len = src.len;
-    if (copy_len > n)
+    return &src.str[pos];
+}
+
+STRNGR_API const char *strngr_view_strrchr(const str_view_t src, const char matcher)
+{
+    if (src.str == NULL)
     {
-        copy_len = n;
+        return NULL;
     }
 
-    /* Copy the characters */
-    memcpy((void *)dst->str, (void *)src.str, (size_t)copy_len);
-
-    /* If source is shorter than n, pad with zeros (like standard strncpy) */
-    if (copy_len < n)
+    const uint32_t pos = strngr_find_byte_last(src.str, src.len, matcher);
+    if (pos >= src.len)
     {
-        memset((void *)(dst->str + copy_len), 0U, (size_t)(n - copy_len));
+        return NULL;
     }
 
-    /* Update the length */
-    dst->len = copy_len;
+    return &src.str[pos];
 }
 
-str_t strngr_strstr(const str_t hay, const str_t needle)
+STRNGR_API str_view_t strngr_view_strrstr(const str_view_t hay, const str_view_t needle)
 {
-    str_t result = {0U, 0U, NULL, 0U};
+    str_view_t result = {NULL, 0U};
 
     if ((hay.str == NULL) || (needle.str == NULL))
     {
@@ -255,87 +4767,116 @@ str_t strngr_strstr(const str_t hay, const str_t needle)
         return result;
     }
 
-    const uint32_t search_len = hay.len - needle.len;
-    for (uint32_t i = 0U; i <= search_len; i++)
+    /* An empty needle matches at the end of the haystack */
+    uint32_t i = hay.len;
+    if (needle.len != 0U)
     {
-        uint32_t j = 0U;
-        for (j = 0U; j < needle.len; j++)
-        {
-            if (needle.str[j] != hay.str[i + j])
-            {
-                break;
-            }
-        }
-
-        if (j == needle.len)
+        i = strngr_find_sub_last(hay.str, hay.len, needle.str, needle.len);
+        if (i >= hay.len)
         {
-            /* Found - return a view from the match position to end of haystack */
-            result.str     = &hay.str[i];
-            result.len     = hay.len - i;
-            result.max_len = hay.len - i;
-            result.term    = hay.term;
             return result;
         }
     }
 
+    result.str = &hay.str[i];
+    result.len = hay.len - i;
+
     return result;
 }
 
-str_t strngr_strsub(const str_t src, const int32_t start, const int32_t end)
+STRNGR_API uint32_t strngr_view_strspn(const str_view_t src, const strngr_byteset_t *set)
 {
-    str_t result = {0U, 0U, NULL, 0U};
+    if ((src.str == NULL) || (set == NULL))
+    {
+        return 0U;
+    }
 
-    if (src.str == NULL)
+    return strngr_find_class(src.str, src.len, set, 0U);
+}
+
+STRNGR_API str_view_t strngr_view_strstr(const str_view_t hay, const str_view_t needle)
+{
+    str_view_t result = {NULL, 0U};
+
+    if ((hay.str == NULL) || (needle.str == NULL))
     {
         return result;
     }
 
-    /* Prevent overflow when casting src.len to signed */
-    if (src.len > (uint32_t)INT32_MAX)
+    if (hay.len < needle.len)
     {
         return result;
     }
 
-    int32_t src_len = (int32_t)src.len;
-
-    /* Convert negative start to offset from end */
-    int32_t actual_start = start;
-    if (start < 0)
+    /* An empty needle matches at the start of the haystack */
+    uint32_t i = 0U;
+    if (needle.len != 0U)
     {
-        actual_start = src_len + start;
+        i = strngr_find_sub(hay.str, hay.len, needle.str, needle.len);
+        if (i >= hay.len)
+        {
+            return result;
+        }
     }
 
-    /* Convert negative end to offset from end */
-    int32_t actual_end = end;
-    if (end < 0)
+    result.str = &hay.str[i];
+    result.len = hay.len - i;
+
+    return result;
+}
+
+STRNGR_API str_view_t strngr_view_strstr_compiled(const str_view_t hay, const strngr_needle_t *needle)
+{
+    str_view_t result = {NULL, 0U};
+
+    if ((hay.str == NULL) || (needle == NULL) || (needle->pattern.str == NULL))
     {
-        actual_end = src_len + end;
+        return result;
     }
 
-    /* Clamp positions to valid range */
-    if (actual_start < 0)
+    const str_t n = needle->pattern;
+    if (hay.len < n.len)
     {
-        actual_start = 0;
+        return result;
     }
-    if (actual_end > src_len)
+
+    /* An empty needle matches at the start of the haystack */
+    const uint32_t i = (n.len == 0U) ? 0U : strngr_needle_find(needle, hay.str, hay.len);
+
+    if ((n.len != 0U) && (i >= hay.len))
     {
-        actual_end = src_len;
+        return result;
     }
 
-    /* Check that start is before end */
-    if (actual_start >= actual_end)
+    result.str = &hay.str[i];
+    result.len = hay.len - i;
+
+    return result;
+}
+
+STRNGR_API str_view_t strngr_view_strsub(const str_view_t src, const int32_t start, const int32_t end)
+{
+    str_view_t result  = {NULL, 0U};
+    uint32_t   off     = 0U;
+    uint32_t   sub_len = 0U;
+
+    if (src.str == NULL)
     {
         return result;
     }
 
-    /* Calculate substring length - guaranteed non-negative after above checks */
-    int32_t sub_len = actual_end - actual_start;
+    if (strngr_sub_range(src.len, start, end, &off, &sub_len) == 0U)
+    {
+        return result;
+    }
 
-    /* Create the substring view */
-    result.str     = &src.str[actual_start];
-    result.len     = (uint32_t)sub_len;
-    result.max_len = (uint32_t)sub_len;
-    result.term    = src.term;
+    result.str = &src.str[off];
+    result.len = sub_len;
 
     return result;
 }
+
+STRNGR_API str_view_t strngr_view_trim(const str_view_t src, const strngr_byteset_t *set)
+{
+    return strngr_view_trim_ends(src, set, STRNGR_TRIM_LEFT | STRNGR_TRIM_RIGHT);
+}
@@ -3,6 +3,18 @@
 
 #include <stdint.h>
 
+/* Define STRNGR_HEADER_ONLY before including strngr.h to compile the whole library into the including
+ * translation unit as static inline functions. The default build links strngr.c as usual. */
+#if defined(STRNGR_HEADER_ONLY)
+#define STRNGR_API static inline
+#else
+#define STRNGR_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef struct
 {
     uint32_t max_len;
@@ -11,22 +23,374 @@ typedef struct
     uint32_t term;
 } str_t;
 
+/* Read-only view; 16 bytes, so it is passed in two registers */
+typedef struct
+{
+    const char *str;
+    uint32_t    len;
+} str_view_t;
+
+/* str_t.term flags */
+#define STRNGR_FLAG_NO_SCRUB   (0x1U)
+#define STRNGR_FLAG_TERMINATED (0x2U)
+
+/* Build with -DSTRNGR_NO_SCRUB to make strngr_new / strngr_new_s skip zeroing by default */
+#if defined(STRNGR_NO_SCRUB)
+#define STRNGR_DEFAULT_FLAGS (STRNGR_FLAG_NO_SCRUB)
+#else
+#define STRNGR_DEFAULT_FLAGS (0U)
+#endif
+
+typedef struct
+{
+    char    *mem;
+    uint32_t size;
+    uint32_t used;
+    uint32_t flags;
+} strngr_arena_t;
+
+typedef struct
+{
+    uint32_t split;
+    uint32_t period;
+    uint32_t mem0;
+    uint32_t byteset[8];
+    uint8_t  shift[256];
+} strngr_twoway_t;
+
+typedef struct
+{
+    str_t           pattern;
+    uint32_t        rare1;
+    uint32_t        rare2;
+    strngr_twoway_t tw;
+} strngr_needle_t;
+
+typedef struct
+{
+    uint32_t pattern;
+    uint32_t offset;
+} strngr_match_t;
+
+/* Return non-zero to stop the scan. Every engine reports matches in order of offset, and matches at the same
+ * offset in order of pattern index. */
+typedef uint32_t (*strngr_match_cb_t)(void *ctx, const strngr_match_t *match);
+
+#define STRNGR_MULTI_DFA       (1U)
+#define STRNGR_MULTI_TEDDY     (2U)
+#define STRNGR_MULTI_TEDDY_MAX (8U)
+
+typedef struct
+{
+    const str_t *patterns;
+    uint32_t     count;
+    uint32_t     engine;
+    uint32_t     states;
+    uint32_t     classes;
+    uint16_t     class_map[256];
+    uint32_t    *trans;
+    uint32_t    *out;
+    uint32_t    *dict;
+    uint32_t    *depth;
+    uint32_t    *next;
+    uint32_t     pending;
+    uint8_t      teddy_lo[3][16];
+    uint8_t      teddy_hi[3][16];
+    uint32_t     teddy_len;
+} strngr_multi_t;
+
+/* Open-addressing str_t -> uint64_t map. Slots are scanned in groups of STRNGR_MAP_GROUP control bytes; the
+ * table never grows, and inserts fail once 7/8 of the slots have been used. */
+#define STRNGR_MAP_GROUP (16U)
+
+typedef struct
+{
+    str_view_t key;
+    uint64_t   hash;
+    uint64_t   value;
+} strngr_map_entry_t;
+
+typedef struct
+{
+    uint8_t            *ctrl;
+    strngr_map_entry_t *entries;
+    strngr_arena_t     *arena;
+    uint64_t            seed;
+    uint32_t            capacity;
+    uint32_t            count;
+    uint32_t            used;
+} strngr_map_t;
+
+/* Interning pool: one canonical copy of each distinct string, so interned strings compare by pointer.
+ * Lookups are wait-free and may run on any number of threads; inserts take a spinlock. */
+typedef struct
+{
+    const void    **slots;
+    strngr_arena_t *arena;
+    uint64_t        seed;
+    uint32_t        capacity;
+    uint32_t        count;
+    uint32_t        lock;
+} strngr_intern_t;
+
+/* strngr_count / strngr_find_all modes: whether a match may start inside the previous one ("aa" occurs
+ * three times in "aaaa" when overlapping, twice otherwise) */
+#define STRNGR_NON_OVERLAPPING (0U)
+#define STRNGR_OVERLAPPING     (1U)
+
+typedef struct
+{
+    uint32_t pattern;
+    uint64_t offset;
+} strngr_stream_match_t;
+
+/* Return non-zero to stop the stream; later feeds then report nothing */
+typedef uint32_t (*strngr_stream_cb_t)(void *ctx, const strngr_stream_match_t *match);
+
+/* Resumable search over data fed in chunks. Only the last (longest needle - 1) bytes are kept between chunks,
+ * in caller memory of strngr_stream_mem_required bytes; offsets count from the start of the stream. Each feed
+ * reports in start order, but a match is only reported by the feed that completes it. */
+typedef struct
+{
+    const strngr_needle_t *needle;
+    const strngr_multi_t  *multi;
+    char                  *mem;
+    uint32_t               keep;
+    uint32_t               carry;
+    uint64_t               consumed;
+    uint32_t               stopped;
+} strngr_stream_t;
+
+/* strngr_split_init flags. STRNGR_SPLIT_QUOTED ignores separators between a pair of quote bytes ('"' unless
+ * the iterator's quote field is changed after init); the quotes stay part of the token. */
+#define STRNGR_SPLIT_SKIP_EMPTY (0x1U)
+#define STRNGR_SPLIT_QUOTED     (0x2U)
+
+/* Compiled byte class: a 256-bit membership bitmap. Up to four members are also listed in any[], and when the
+ * members fall into at most eight distinct high-nibble rows (nibble set), lo[b & 15] & hi[b >> 4] is non-zero
+ * exactly for members so vectors are classified with two table shuffles. */
+typedef struct
+{
+    uint32_t bits[8];
+    uint8_t  lo[16];
+    uint8_t  hi[16];
+    uint8_t  any[4];
+    uint32_t count;
+    uint32_t nibble;
+} strngr_byteset_t;
+
+/* Compiled byte translation: map[b] replaces b. Bit h of rows is set when some byte with high nibble h changes. */
+typedef struct
+{
+    uint8_t  map[256];
+    uint32_t rows;
+} strngr_tr_t;
+
+typedef struct
+{
+    str_view_t       src;
+    str_view_t       sep;
+    uint32_t         pos;
+    uint32_t         flags;
+    uint32_t         mode;
+    uint32_t         done;
+    char             quote;
+    strngr_byteset_t set;
+} strngr_split_iter_t;
+
+/* strngr_lines_init flags */
+#define STRNGR_LINES_STRIP_CR (0x1U)
+
+/* Line iterator; newline positions are found 64 bytes at a time and buffered in nl[] */
+typedef struct
+{
+    str_view_t src;
+    uint32_t   pos;
+    uint32_t   scan;
+    uint32_t   flags;
+    uint32_t   head;
+    uint32_t   count;
+    uint32_t   nl[64];
+} strngr_lines_t;
+
 #define STR_T_FROM_CHAR(char_str) \
     ((str_t){.str = char_str, .len = strlen(char_str), .max_len = strlen(char_str), .term = 0U})
 
-char *strngr_new(str_t *str, char *mem, const uint32_t mem_len);
-str_t strngr_new_s(char *mem, const uint32_t mem_len, const char *string);
-
-void     strngr_reset_to_empty(str_t *str);
-void     strngr_strcat(str_t *dst, const str_t src);
-char    *strngr_strchr(const str_t src, const char matcher);
-void     strngr_strcpy(const str_t src, str_t *dst);
-uint32_t strngr_strcspn(const str_t src, const char matcher);
-uint32_t strngr_strlen(const str_t src);
-void     strngr_strncat(str_t *dst, const str_t src, uint32_t n);
-int32_t  strngr_strncmp(const str_t a, const str_t b, uint32_t n);
-void     strngr_strncpy(const str_t src, str_t *dst, uint32_t n);
-str_t    strngr_strstr(const str_t hay, const str_t needle);
-str_t    strngr_strsub(const str_t src, const int32_t start, const int32_t end);
+/* Literal-only wrappers with the length taken from sizeof. The terminator is counted in max_len so the
+ * result is a terminated string. STR_T_LITERAL_INIT is a constant initializer for static const str_t. */
+#define STR_T_LITERAL_INIT(lit) \
+    {(uint32_t)sizeof("" lit ""), (uint32_t)(sizeof("" lit "") - 1U), (char *)("" lit ""), STRNGR_FLAG_TERMINATED}
+#define STR_T_LITERAL(lit) ((str_t)STR_T_LITERAL_INIT(lit))
+
+#define STR_VIEW_LITERAL_INIT(lit) {("" lit ""), (uint32_t)(sizeof("" lit "") - 1U)}
+#define STR_VIEW_LITERAL(lit)      ((str_view_t)STR_VIEW_LITERAL_INIT(lit))
+
+STRNGR_API void           *strngr_arena_alloc(strngr_arena_t *arena, const uint32_t size, const uint32_t align);
+STRNGR_API strngr_arena_t *strngr_arena_init(strngr_arena_t *arena, void *mem, const uint32_t mem_len,
+                                             const uint32_t flags);
+STRNGR_API uint32_t        strngr_arena_mark(const strngr_arena_t *arena);
+STRNGR_API str_t           strngr_arena_new(strngr_arena_t *arena, const uint32_t max_len);
+STRNGR_API str_t           strngr_arena_new_s(strngr_arena_t *arena, const char *string);
+STRNGR_API void            strngr_arena_reset(strngr_arena_t *arena);
+STRNGR_API void            strngr_arena_rewind(strngr_arena_t *arena, const uint32_t mark);
+STRNGR_API void            strngr_arena_strcat(strngr_arena_t *arena, str_t *dst, const str_t src);
+STRNGR_API str_t           strngr_arena_strsub(strngr_arena_t *arena, const str_t src, const int32_t start,
+                                               const int32_t end);
+
+STRNGR_API strngr_byteset_t *strngr_byteset_compile(strngr_byteset_t *set, const str_t members);
+
+STRNGR_API void        strngr_collapse_ws(str_t *str, const strngr_byteset_t *set);
+STRNGR_API uint32_t    strngr_count(const str_t hay, const str_t needle, const uint32_t mode);
+STRNGR_API uint32_t    strngr_count_lines(const str_t src);
+STRNGR_API const char *strngr_cstr(const str_t src);
+STRNGR_API uint32_t    strngr_equal(const str_t a, const str_t b);
+STRNGR_API uint32_t    strngr_equal_nocase(const str_t a, const str_t b);
+STRNGR_API uint32_t    strngr_find_all(const str_t hay, const str_t needle, uint32_t *out_offsets, const uint32_t cap,
+                                       const uint32_t mode);
+STRNGR_API uint32_t    strngr_find_all_compiled(const str_t hay, const strngr_needle_t *needle, uint32_t *out_offsets,
+                                                const uint32_t cap, const uint32_t mode);
+
+STRNGR_API uint64_t strngr_hash(const str_t src);
+STRNGR_API uint64_t strngr_hash_nocase(const str_t src);
+STRNGR_API uint64_t strngr_hash_seeded(const str_t src, const uint64_t seed);
+
+STRNGR_API str_view_t       strngr_intern(strngr_intern_t *pool, const str_t src);
+STRNGR_API str_view_t       strngr_intern_find(const strngr_intern_t *pool, const str_t src);
+STRNGR_API strngr_intern_t *strngr_intern_init(strngr_intern_t *pool, strngr_arena_t *arena, const uint32_t capacity,
+                                               const uint64_t seed);
+STRNGR_API uint32_t         strngr_intern_mem_required(const uint32_t capacity);
+
+STRNGR_API strngr_lines_t *strngr_lines_init(strngr_lines_t *it, const str_t src, const uint32_t flags);
+STRNGR_API uint32_t        strngr_lines_next(strngr_lines_t *it, str_view_t *line);
+
+STRNGR_API str_t strngr_ltrim(const str_t src, const strngr_byteset_t *set);
+
+STRNGR_API uint64_t     *strngr_map_find(const strngr_map_t *map, const str_t key);
+STRNGR_API strngr_map_t *strngr_map_init(strngr_map_t *map, strngr_arena_t *arena, const uint32_t capacity,
+                                         const uint64_t seed);
+STRNGR_API uint32_t      strngr_map_mem_required(const uint32_t capacity);
+STRNGR_API uint64_t     *strngr_map_put(strngr_map_t *map, const str_t key, const uint64_t value);
+STRNGR_API uint32_t      strngr_map_remove(strngr_map_t *map, const str_t key);
+
+STRNGR_API strngr_multi_t *strngr_multi_compile(strngr_multi_t *multi, const str_t *patterns, const uint32_t count,
+                                                void *mem, const uint32_t mem_len);
+STRNGR_API uint32_t        strngr_multi_find_all(const strngr_multi_t *multi, const str_t hay, strngr_match_t *out,
+                                                 const uint32_t cap);
+STRNGR_API uint32_t        strngr_multi_mem_required(const str_t *patterns, const uint32_t count);
+STRNGR_API uint32_t        strngr_multi_scan(const strngr_multi_t *multi, const str_t hay, strngr_match_cb_t fn,
+                                             void *ctx);
+
+STRNGR_API strngr_needle_t *strngr_needle_compile(strngr_needle_t *needle, const str_t pattern);
+
+STRNGR_API char    *strngr_new(str_t *str, char *mem, const uint32_t mem_len);
+STRNGR_API char    *strngr_new_ex(str_t *str, char *mem, const uint32_t mem_len, const uint32_t flags);
+STRNGR_API str_t    strngr_new_s(char *mem, const uint32_t mem_len, const char *string);
+STRNGR_API uint32_t strngr_new_s_bulk(str_t *out, const char *const *strings, const uint32_t count, char *mem,
+                                      const uint32_t mem_len, const uint32_t flags);
+STRNGR_API str_t    strngr_new_s_ex(char *mem, const uint32_t mem_len, const char *string, const uint32_t flags);
+STRNGR_API str_t    strngr_new_s_trunc(char *mem, const uint32_t mem_len, const char *string, const uint32_t flags,
+                                       uint32_t *truncated);
+
+STRNGR_API uint32_t             strngr_split_all(strngr_split_iter_t *it, str_view_t *out, const uint32_t cap);
+STRNGR_API strngr_split_iter_t *strngr_split_init(strngr_split_iter_t *it, const str_t src, const str_t sep,
+                                                  const uint32_t flags);
+STRNGR_API strngr_split_iter_t *strngr_split_init_set(strngr_split_iter_t *it, const str_t src, const str_t set,
+                                                      const uint32_t flags);
+STRNGR_API uint32_t             strngr_split_next(strngr_split_iter_t *it, str_view_t *token);
+
+STRNGR_API void     strngr_reset_to_empty(str_t *str);
+STRNGR_API str_t    strngr_rtrim(const str_t src, const strngr_byteset_t *set);
+STRNGR_API uint32_t         strngr_stream_feed(strngr_stream_t *st, const str_t chunk, strngr_stream_cb_t fn,
+                                               void *ctx);
+STRNGR_API strngr_stream_t *strngr_stream_init(strngr_stream_t *st, const strngr_needle_t *needle, char *mem,
+                                               const uint32_t mem_len);
+STRNGR_API strngr_stream_t *strngr_stream_init_multi(strngr_stream_t *st, const strngr_multi_t *multi, char *mem,
+                                                     const uint32_t mem_len);
+STRNGR_API uint32_t         strngr_stream_mem_required(const uint32_t max_needle_len);
+
+STRNGR_API void     strngr_strcat(str_t *dst, const str_t src);
+STRNGR_API str_t    strngr_strcasestr(const str_t hay, const str_t needle);
+STRNGR_API char    *strngr_strchr(const str_t src, const char matcher);
+STRNGR_API void     strngr_strcpy(const str_t src, str_t *dst);
+STRNGR_API uint32_t strngr_strcspn(const str_t src, const char matcher);
+STRNGR_API uint32_t strngr_strcspn_set(const str_t src, const strngr_byteset_t *set);
+STRNGR_API uint32_t strngr_strlen(const str_t src);
+STRNGR_API void     strngr_strncat(str_t *dst, const str_t src, uint32_t n);
+STRNGR_API int32_t  strngr_strncasecmp(const str_t a, const str_t b, uint32_t n);
+STRNGR_API int32_t  strngr_strncmp(const str_t a, const str_t b, uint32_t n);
+STRNGR_API void     strngr_strncpy(const str_t src, str_t *dst, uint32_t n);
+STRNGR_API char    *strngr_strpbrk(const str_t src, const strngr_byteset_t *set);
+STRNGR_API char    *strngr_strrchr(const str_t src, const char matcher);
+STRNGR_API str_t    strngr_strrstr(const str_t hay, const str_t needle);
+STRNGR_API uint32_t strngr_strspn(const str_t src, const strngr_byteset_t *set);
+STRNGR_API str_t    strngr_strstr(const str_t hay, const str_t needle);
+STRNGR_API str_t    strngr_strstr_compiled(const str_t hay, const strngr_needle_t *needle);
+STRNGR_API str_t    strngr_strsub(const str_t src, const int32_t start, const int32_t end);
+
+STRNGR_API void         strngr_to_lower(str_t *str);
+STRNGR_API void         strngr_to_lower_cpy(const str_t src, str_t *dst);
+STRNGR_API void         strngr_to_upper(str_t *str);
+STRNGR_API void         strngr_to_upper_cpy(const str_t src, str_t *dst);
+STRNGR_API strngr_tr_t *strngr_tr_compile(strngr_tr_t *tr, const str_t from, const str_t to);
+STRNGR_API strngr_tr_t *strngr_tr_compile_table(strngr_tr_t *tr, const uint8_t table[256]);
+STRNGR_API void         strngr_translate(str_t *str, const strngr_tr_t *tr);
+STRNGR_API void         strngr_translate_cpy(const str_t src, str_t *dst, const strngr_tr_t *tr);
+STRNGR_API str_t        strngr_trim(const str_t src, const strngr_byteset_t *set);
+
+STRNGR_API str_view_t  strngr_view(const str_t *src);
+STRNGR_API uint32_t    strngr_view_count(const str_view_t hay, const str_view_t needle, const uint32_t mode);
+STRNGR_API uint32_t    strngr_view_count_lines(const str_view_t src);
+STRNGR_API uint32_t    strngr_view_equal(const str_view_t a, const str_view_t b);
+STRNGR_API uint32_t    strngr_view_equal_nocase(const str_view_t a, const str_view_t b);
+STRNGR_API uint32_t    strngr_view_find_all(const str_view_t hay, const str_view_t needle, uint32_t *out_offsets,
+                                            const uint32_t cap, const uint32_t mode);
+STRNGR_API uint32_t    strngr_view_find_all_compiled(const str_view_t hay, const strngr_needle_t *needle,
+                                                     uint32_t *out_offsets, const uint32_t cap, const uint32_t mode);
+STRNGR_API uint64_t    strngr_view_hash(const str_view_t src, const uint64_t seed);
+STRNGR_API uint64_t    strngr_view_hash_nocase(const str_view_t src, const uint64_t seed);
+STRNGR_API str_view_t  strngr_view_intern(strngr_intern_t *pool, const str_view_t src);
+STRNGR_API str_view_t  strngr_view_intern_find(const strngr_intern_t *pool, const str_view_t src);
+
+STRNGR_API strngr_lines_t *strngr_view_lines_init(strngr_lines_t *it, const str_view_t src, const uint32_t flags);
+
+STRNGR_API str_view_t  strngr_view_ltrim(const str_view_t src, const strngr_byteset_t *set);
+STRNGR_API uint64_t   *strngr_view_map_find(const strngr_map_t *map, const str_view_t key);
+STRNGR_API uint32_t    strngr_view_multi_find_all(const strngr_multi_t *multi, const str_view_t hay,
+                                                  strngr_match_t *out, const uint32_t cap);
+STRNGR_API uint32_t    strngr_view_multi_scan(const strngr_multi_t *multi, const str_view_t hay, strngr_match_cb_t fn,
+                                              void *ctx);
+STRNGR_API str_view_t  strngr_view_rtrim(const str_view_t src, const strngr_byteset_t *set);
+
+STRNGR_API strngr_split_iter_t *strngr_view_split_init(strngr_split_iter_t *it, const str_view_t src,
+                                                       const str_view_t sep, const uint32_t flags);
+STRNGR_API strngr_split_iter_t *strngr_view_split_init_set(strngr_split_iter_t *it, const str_view_t src,
+                                                           const str_view_t set, const uint32_t flags);
+
+STRNGR_API uint32_t strngr_view_stream_feed(strngr_stream_t *st, const str_view_t chunk, strngr_stream_cb_t fn,
+                                            void *ctx);
+
+STRNGR_API str_view_t  strngr_view_strcasestr(const str_view_t hay, const str_view_t needle);
+STRNGR_API const char *strngr_view_strchr(const str_view_t src, const char matcher);
+STRNGR_API uint32_t    strngr_view_strcspn(const str_view_t src, const char matcher);
+STRNGR_API uint32_t    strngr_view_strcspn_set(const str_view_t src, const strngr_byteset_t *set);
+STRNGR_API uint32_t    strngr_view_strlen(const str_view_t src);
+STRNGR_API int32_t     strngr_view_strncasecmp(const str_view_t a, const str_view_t b, uint32_t n);
+STRNGR_API int32_t     strngr_view_strncmp(const str_view_t a, const str_view_t b, uint32_t n);
+STRNGR_API const char *strngr_view_strpbrk(const str_view_t src, const strngr_byteset_t *set);
+STRNGR_API const char *strngr_view_strrchr(const str_view_t src, const char matcher);
+STRNGR_API str_view_t  strngr_view_strrstr(const str_view_t hay, const str_view_t needle);
+STRNGR_API uint32_t    strngr_view_strspn(const str_view_t src, const strngr_byteset_t *set);
+STRNGR_API str_view_t  strngr_view_strstr(const str_view_t hay, const str_view_t needle);
+STRNGR_API str_view_t  strngr_view_strstr_compiled(const str_view_t hay, const strngr_needle_t *needle);
+STRNGR_API str_view_t  strngr_view_strsub(const str_view_t src, const int32_t start, const int32_t end);
+STRNGR_API str_view_t  strngr_view_trim(const str_view_t src, const strngr_byteset_t *set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(STRNGR_HEADER_ONLY)
+#include "strngr.c"
+#endif
 
 #endif
@@ -0,0 +1,30 @@
+#ifndef __STRNGR_HPP__
+#define __STRNGR_HPP__
+
+#include "strngr.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__cpp_consteval)
+#define STRNGR_CONSTEVAL consteval
+#else
+#define STRNGR_CONSTEVAL constexpr
+#endif
+
+namespace strngr
+{
+namespace literals
+{
+
+/* "abc"_s is a terminated str_t over the literal, built at compile time */
+STRNGR_CONSTEVAL str_t operator""_s(const char *str, std::size_t len)
+{
+    return str_t{static_cast<uint32_t>(len + 1U), static_cast<uint32_t>(len), const_cast<char *>(str),
+                 STRNGR_FLAG_TERMINATED};
+}
+
+} // namespace literals
+} // namespace strngr
+
+#endif
@@ -0,0 +1,161 @@
+/* mmap, madvise and friends are outside strict C99; ask for them before any system header */
+#if !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "strngr_file.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STRNGR_FILE_POSIX
+#endif
+
+/* Empty files cannot be mapped; they all share this buffer instead */
+static char strngr_file_empty[1] = {'\0'};
+
+static void strngr_file_clear(strngr_file_t *file)
+{
+    file->view.max_len = 0U;
+    file->view.len     = 0U;
+    file->view.str     = NULL;
+    file->view.term    = 0U;
+    file->base         = NULL;
+    file->size         = 0U;
+}
+
+#if defined(STRNGR_FILE_POSIX)
+/* Pass the access-pattern flags on to the kernel. Hints are best effort; a kernel that ignores them still leaves a
+ * valid mapping. A header-only build can read <sys/mman.h> before this file asks for _DEFAULT_SOURCE, so each call
+ * is used only if its constants were declared, falling back from posix_madvise to madvise to nothing. */
+static void strngr_file_advise(void *base, const size_t size, const uint32_t flags)
+{
+#if defined(POSIX_MADV_SEQUENTIAL)
+    if ((flags & STRNGR_FILE_SEQUENTIAL) != 0U)
+    {
+        (void)posix_madvise(base, size, POSIX_MADV_SEQUENTIAL);
+    }
+    if ((flags & STRNGR_FILE_WILLNEED) != 0U)
+    {
+        (void)posix_madvise(base, size, POSIX_MADV_WILLNEED);
+    }
+#elif defined(MADV_SEQUENTIAL)
+    if ((flags & STRNGR_FILE_SEQUENTIAL) != 0U)
+    {
+        (void)madvise(base, size, MADV_SEQUENTIAL);
+    }
+    if ((flags & STRNGR_FILE_WILLNEED) != 0U)
+    {
+        (void)madvise(base, size, MADV_WILLNEED);
+    }
+#endif
+#if defined(MADV_HUGEPAGE)
+    if ((flags & STRNGR_FILE_HUGEPAGE) != 0U)
+    {
+        (void)madvise(base, size, MADV_HUGEPAGE);
+    }
+#endif
+    (void)base;
+    (void)size;
+    (void)flags;
+}
+#endif
+
+STRNGR_API str_view_t strngr_file_window(const strngr_file_t *file, const uint64_t offset)
+{
+    str_view_t result = {NULL, 0U};
+
+    if ((file == NULL) || (file->view.str == NULL) || (offset > file->size))
+    {
+        return result;
+    }
+
+    /* Up to UINT32_MAX bytes from offset; large files are walked one window at a time */
+    const uint64_t rest = file->size - offset;
+    result.str = &file->view.str[offset];
+    result.len = (rest > (uint64_t)UINT32_MAX) ? UINT32_MAX : (uint32_t)rest;
+
+    return result;
+}
+
+STRNGR_API strngr_file_t *strngr_map_file(strngr_file_t *file, const char *path, const uint32_t flags)
+{
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    strngr_file_clear(file);
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+#if defined(STRNGR_FILE_POSIX)
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (!S_ISREG(st.st_mode)) || (st.st_size < 0) ||
+        ((uint64_t)st.st_size > (uint64_t)SIZE_MAX) ||
+        (((flags & STRNGR_FILE_LARGE) == 0U) && ((uint64_t)st.st_size > (uint64_t)UINT32_MAX)))
+    {
+        (void)close(fd);
+        return NULL;
+    }
+
+    const uint64_t size = (uint64_t)st.st_size;
+    if (size == 0U)
+    {
+        (void)close(fd);
+        file->view.str = strngr_file_empty;
+        return file;
+    }
+
+    /* The mapping keeps its own reference to the file */
+    void *base = mmap(NULL, (size_t)size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (base == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    strngr_file_advise(base, (size_t)size, flags);
+
+    file->base         = base;
+    file->size         = size;
+    file->view.str     = (char *)base;
+    file->view.len     = (size > (uint64_t)UINT32_MAX) ? UINT32_MAX : (uint32_t)size;
+    file->view.max_len = file->view.len;
+
+    return file;
+#else
+    (void)flags;
+    return NULL;
+#endif
+}
+
+STRNGR_API void strngr_unmap_file(strngr_file_t *file)
+{
+    if (file == NULL)
+    {
+        return;
+    }
+
+#if defined(STRNGR_FILE_POSIX)
+    if (file->base != NULL)
+    {
+        (void)munmap(file->base, (size_t)file->size);
+    }
+#endif
+
+    strngr_file_clear(file);
+}
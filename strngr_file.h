@@ -0,0 +1,45 @@
+#ifndef __STRNGR_FILE__
+#define __STRNGR_FILE__
+
+/* Header-only builds compile strngr_file.c into the including file, after the system headers below; the feature
+ * test macro has to come first. It only takes effect if no system header was included before this one. */
+#if defined(STRNGR_HEADER_ONLY) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "strngr.h"
+
+/* Memory-mapped files as read-only strings. POSIX only; on other platforms strngr_map_file always fails.
+ * Kept out of strngr.c so the core library stays free of OS dependencies. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* strngr_map_file flags: access-pattern hints passed on to the kernel, and STRNGR_FILE_LARGE to accept files
+ * longer than UINT32_MAX bytes */
+#define STRNGR_FILE_SEQUENTIAL (0x1U)
+#define STRNGR_FILE_WILLNEED   (0x2U)
+#define STRNGR_FILE_HUGEPAGE   (0x4U)
+#define STRNGR_FILE_LARGE      (0x8U)
+
+typedef struct
+{
+    str_t    view;
+    void    *base;
+    uint64_t size;
+} strngr_file_t;
+
+STRNGR_API strngr_file_t *strngr_map_file(strngr_file_t *file, const char *path, const uint32_t flags);
+STRNGR_API void           strngr_unmap_file(strngr_file_t *file);
+STRNGR_API str_view_t     strngr_file_window(const strngr_file_t *file, const uint64_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(STRNGR_HEADER_ONLY)
+#include "strngr_file.c"
+#endif
+
+#endif
@@ -0,0 +1,405 @@
+#include "strngr_par.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define STRNGR_PAR_NONE (UINT32_MAX)
+
+/* One parallel search: the haystack split into chunks, with per-chunk results for a deterministic merge */
+typedef struct
+{
+    str_view_t             hay;
+    const strngr_needle_t *needle;
+    uint32_t               chunk;
+    uint32_t               chunks;
+    uint32_t               best;
+    uint32_t              *out;
+    uint32_t               cap;
+    uint32_t               counts[STRNGR_PAR_MAX_CHUNKS];
+    uint32_t               base[STRNGR_PAR_MAX_CHUNKS];
+} strngr_par_job_t;
+
+static uint32_t strngr_par_claim(uint32_t *next)
+{
+    return __atomic_fetch_add(next, 1U, __ATOMIC_RELAXED);
+}
+
+static void *strngr_par_worker(void *ctx)
+{
+    strngr_par_pool_t *pool = (strngr_par_pool_t *)ctx;
+    uint32_t           seen = 0U;
+
+    (void)pthread_mutex_lock(&pool->lock);
+    for (;;)
+    {
+        while ((pool->generation == seen) && (pool->shutdown == 0U))
+        {
+            (void)pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->shutdown != 0U)
+        {
+            break;
+        }
+        seen = pool->generation;
+        (void)pthread_mutex_unlock(&pool->lock);
+
+        /* Tasks are claimed from a shared counter, so a thread that finishes early takes over the rest */
+        for (uint32_t i = strngr_par_claim(&pool->next); i < pool->tasks; i = strngr_par_claim(&pool->next))
+        {
+            pool->fn(pool->arg, i);
+        }
+
+        (void)pthread_mutex_lock(&pool->lock);
+        pool->active--;
+        if (pool->active == 0U)
+        {
+            (void)pthread_cond_signal(&pool->done);
+        }
+    }
+    (void)pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+static void strngr_par_pool_run(void *ctx, strngr_par_task_t fn, void *arg, const uint32_t count)
+{
+    strngr_par_pool_t *pool = (strngr_par_pool_t *)ctx;
+
+    /* One job at a time per pool */
+    (void)pthread_mutex_lock(&pool->busy);
+
+    (void)pthread_mutex_lock(&pool->lock);
+    pool->fn     = fn;
+    pool->arg    = arg;
+    pool->tasks  = count;
+    pool->next   = 0U;
+    pool->active = pool->count;
+    pool->generation++;
+    (void)pthread_cond_broadcast(&pool->wake);
+    (void)pthread_mutex_unlock(&pool->lock);
+
+    /* The calling thread works too */
+    for (uint32_t i = strngr_par_claim(&pool->next); i < count; i = strngr_par_claim(&pool->next))
+    {
+        fn(arg, i);
+    }
+
+    (void)pthread_mutex_lock(&pool->lock);
+    while (pool->active != 0U)
+    {
+        (void)pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    (void)pthread_mutex_unlock(&pool->lock);
+
+    (void)pthread_mutex_unlock(&pool->busy);
+}
+
+/* Create the pool's locks and conditions; if one fails, those already made are destroyed in reverse order */
+static uint32_t strngr_par_pool_sync_init(strngr_par_pool_t *pool)
+{
+    if (pthread_mutex_init(&pool->lock, NULL) != 0)
+    {
+        return 0U;
+    }
+
+    if (pthread_mutex_init(&pool->busy, NULL) != 0)
+    {
+        (void)pthread_mutex_destroy(&pool->lock);
+        return 0U;
+    }
+
+    if (pthread_cond_init(&pool->wake, NULL) != 0)
+    {
+        (void)pthread_mutex_destroy(&pool->busy);
+        (void)pthread_mutex_destroy(&pool->lock);
+        return 0U;
+    }
+
+    if (pthread_cond_init(&pool->done, NULL) != 0)
+    {
+        (void)pthread_cond_destroy(&pool->wake);
+        (void)pthread_mutex_destroy(&pool->busy);
+        (void)pthread_mutex_destroy(&pool->lock);
+        return 0U;
+    }
+
+    return 1U;
+}
+
+/* Cut the haystack into chunks: a few per thread for balance, none smaller than STRNGR_PAR_CHUNK_MIN */
+static void strngr_par_plan(strngr_par_job_t *job, const strngr_par_exec_t *exec)
+{
+    const uint32_t threads = ((exec == NULL) || (exec->threads == 0U)) ? 1U : exec->threads;
+    uint64_t       chunks  = (uint64_t)threads * 8U;
+    const uint64_t fit     = (uint64_t)job->hay.len / STRNGR_PAR_CHUNK_MIN;
+
+    chunks = (chunks > fit) ? fit : chunks;
+    chunks = (chunks > STRNGR_PAR_MAX_CHUNKS) ? STRNGR_PAR_MAX_CHUNKS : chunks;
+    chunks = (chunks == 0U) ? 1U : chunks;
+
+    job->chunks = (uint32_t)chunks;
+    job->chunk  = (uint32_t)(((uint64_t)job->hay.len + chunks - 1U) / chunks);
+}
+
+/* Chunk i owns the match starts in [start, end); its search region runs needle length - 1 bytes further */
+static str_view_t strngr_par_region(const strngr_par_job_t *job, const uint32_t i, uint32_t *start)
+{
+    const uint64_t s   = (uint64_t)i * job->chunk;
+    const uint64_t e   = s + job->chunk + job->needle->pattern.len - 1U;
+    str_view_t     reg = {NULL, 0U};
+
+    *start = (uint32_t)s;
+    if (s < job->hay.len)
+    {
+        reg.str = &job->hay.str[s];
+        reg.len = (uint32_t)(((e > job->hay.len) ? job->hay.len : e) - s);
+    }
+
+    return reg;
+}
+
+static void strngr_par_run(const strngr_par_exec_t *exec, strngr_par_task_t fn, strngr_par_job_t *job)
+{
+    if ((exec == NULL) || (exec->run == NULL) || (job->chunks == 1U))
+    {
+        for (uint32_t i = 0U; i < job->chunks; i++)
+        {
+            fn((void *)job, i);
+        }
+        return;
+    }
+
+    exec->run(exec->pool, fn, (void *)job, job->chunks);
+}
+
+/* Occurrences in one region, overlapping ones included; stores up to cap offsets if out is not NULL. The compiled
+ * search steps over each match by the needle's period, so runs of overlapping matches stay linear. */
+static uint32_t strngr_par_scan(const strngr_par_job_t *job, const str_view_t reg, const uint32_t start,
+                                uint32_t *out, const uint32_t cap)
+{
+    const uint32_t n = strngr_view_find_all_compiled(reg, job->needle, out, cap, STRNGR_OVERLAPPING);
+
+    /* Offsets come back relative to the region */
+    const uint32_t stored = (n < cap) ? n : cap;
+    for (uint32_t k = 0U; k < stored; k++)
+    {
+        out[k] += start;
+    }
+
+    return n;
+}
+
+static void strngr_par_first_task(void *arg, const uint32_t i)
+{
+    strngr_par_job_t *job   = (strngr_par_job_t *)arg;
+    uint32_t          start = 0U;
+
+    /* Early cancellation: a match already found further left makes this chunk irrelevant */
+    const str_view_t reg = strngr_par_region(job, i, &start);
+    if ((reg.str == NULL) || (__atomic_load_n(&job->best, __ATOMIC_RELAXED) < start))
+    {
+        return;
+    }
+
+    const str_view_t hit = strngr_view_strstr_compiled(reg, job->needle);
+    if (hit.str == NULL)
+    {
+        return;
+    }
+
+    /* Keep the leftmost match whatever order the chunks finish in */
+    const uint32_t at  = start + (uint32_t)(hit.str - reg.str);
+    uint32_t       cur = __atomic_load_n(&job->best, __ATOMIC_RELAXED);
+    while (at < cur)
+    {
+        /* On failure cur is reloaded with the value another chunk stored */
+        if (__atomic_compare_exchange_n(&job->best, &cur, at, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+}
+
+static void strngr_par_count_task(void *arg, const uint32_t i)
+{
+    strngr_par_job_t *job   = (strngr_par_job_t *)arg;
+    uint32_t          start = 0U;
+
+    const str_view_t reg = strngr_par_region(job, i, &start);
+    job->counts[i]       = (reg.str == NULL) ? 0U : strngr_par_scan(job, reg, start, NULL, 0U);
+}
+
+static void strngr_par_store_task(void *arg, const uint32_t i)
+{
+    strngr_par_job_t *job   = (strngr_par_job_t *)arg;
+    uint32_t          start = 0U;
+
+    /* Second pass: each chunk writes its matches at its prefix-sum position, skipping chunks past cap */
+    const str_view_t reg = strngr_par_region(job, i, &start);
+    if ((reg.str == NULL) || (job->counts[i] == 0U) || (job->base[i] >= job->cap))
+    {
+        return;
+    }
+
+    (void)strngr_par_scan(job, reg, start, &job->out[job->base[i]], job->cap - job->base[i]);
+}
+
+/* Set up a job; zero if there is nothing to search */
+static uint32_t strngr_par_job(strngr_par_job_t *job, const strngr_par_exec_t *exec, const str_t hay,
+                               const strngr_needle_t *needle)
+{
+    if ((hay.str == NULL) || (needle == NULL) || (needle->pattern.str == NULL) || (needle->pattern.len == 0U) ||
+        (hay.len < needle->pattern.len))
+    {
+        return 0U;
+    }
+
+    memset((void *)job, 0, sizeof(*job));
+    job->hay    = strngr_view(&hay);
+    job->needle = needle;
+    job->best   = STRNGR_PAR_NONE;
+    strngr_par_plan(job, exec);
+
+    return 1U;
+}
+
+STRNGR_API uint32_t strngr_par_count(const strngr_par_exec_t *exec, const str_t hay, const strngr_needle_t *needle)
+{
+    strngr_par_job_t job;
+
+    if (strngr_par_job(&job, exec, hay, needle) == 0U)
+    {
+        return 0U;
+    }
+
+    strngr_par_run(exec, strngr_par_count_task, &job);
+
+    uint32_t total = 0U;
+    for (uint32_t i = 0U; i < job.chunks; i++)
+    {
+        total += job.counts[i];
+    }
+
+    return total;
+}
+
+STRNGR_API uint32_t strngr_par_find_all(const strngr_par_exec_t *exec, const str_t hay,
+                                        const strngr_needle_t *needle, uint32_t *out, const uint32_t cap)
+{
+    strngr_par_job_t job;
+
+    if (strngr_par_job(&job, exec, hay, needle) == 0U)
+    {
+        return 0U;
+    }
+
+    /* Count per chunk, then place each chunk's matches by prefix sum, so the output is in ascending order */
+    strngr_par_run(exec, strngr_par_count_task, &job);
+
+    uint32_t total = 0U;
+    for (uint32_t i = 0U; i < job.chunks; i++)
+    {
+        job.base[i] = total;
+        total += job.counts[i];
+    }
+
+    if ((out != NULL) && (cap != 0U) && (total != 0U))
+    {
+        job.out = out;
+        job.cap = cap;
+        strngr_par_run(exec, strngr_par_store_task, &job);
+    }
+
+    return total;
+}
+
+STRNGR_API str_t strngr_par_find_first(const strngr_par_exec_t *exec, const str_t hay, const strngr_needle_t *needle)
+{
+    str_t            result = {0U, 0U, NULL, 0U};
+    strngr_par_job_t job;
+
+    if (strngr_par_job(&job, exec, hay, needle) == 0U)
+    {
+        return result;
+    }
+
+    strngr_par_run(exec, strngr_par_first_task, &job);
+    if (job.best == STRNGR_PAR_NONE)
+    {
+        return result;
+    }
+
+    /* Same view strngr_strstr returns */
+    result.max_len = hay.len - job.best;
+    result.len     = hay.len - job.best;
+    result.str     = &hay.str[job.best];
+    result.term    = hay.term;
+
+    return result;
+}
+
+STRNGR_API void strngr_par_pool_destroy(strngr_par_pool_t *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    (void)pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1U;
+    (void)pthread_cond_broadcast(&pool->wake);
+    (void)pthread_mutex_unlock(&pool->lock);
+
+    for (uint32_t i = 0U; i < pool->count; i++)
+    {
+        (void)pthread_join(pool->workers[i], NULL);
+    }
+
+    (void)pthread_cond_destroy(&pool->done);
+    (void)pthread_cond_destroy(&pool->wake);
+    (void)pthread_mutex_destroy(&pool->busy);
+    (void)pthread_mutex_destroy(&pool->lock);
+    pool->count = 0U;
+}
+
+STRNGR_API strngr_par_exec_t strngr_par_pool_exec(strngr_par_pool_t *pool)
+{
+    strngr_par_exec_t exec = {NULL, NULL, 1U};
+
+    if (pool != NULL)
+    {
+        exec.run     = strngr_par_pool_run;
+        exec.pool    = (void *)pool;
+        exec.threads = pool->count + 1U;
+    }
+
+    return exec;
+}
+
+STRNGR_API strngr_par_pool_t *strngr_par_pool_init(strngr_par_pool_t *pool, const uint32_t threads)
+{
+    if ((pool == NULL) || (threads == 0U) || (threads > (STRNGR_PAR_MAX_THREADS + 1U)))
+    {
+        return NULL;
+    }
+
+    memset((void *)pool, 0, sizeof(*pool));
+    if (strngr_par_pool_sync_init(pool) == 0U)
+    {
+        return NULL;
+    }
+
+    /* threads counts the calling thread, which joins in on every job */
+    for (uint32_t i = 0U; i < (threads - 1U); i++)
+    {
+        if (pthread_create(&pool->workers[i], NULL, strngr_par_worker, (void *)pool) != 0)
+        {
+            strngr_par_pool_destroy(pool);
+            return NULL;
+        }
+        pool->count++;
+    }
+
+    return pool;
+}
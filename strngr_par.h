@@ -0,0 +1,71 @@
+#ifndef __STRNGR_PAR__
+#define __STRNGR_PAR__
+
+#include "strngr.h"
+
+#include <pthread.h>
+
+/* Parallel search over large haystacks. The haystack is cut into chunks that overlap by needle length - 1 bytes,
+ * each chunk is searched with the regular SIMD kernels, and results are merged so they do not depend on thread
+ * timing. POSIX threads; kept out of strngr.c like strngr_file.c. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STRNGR_PAR_MAX_THREADS (64U)
+#define STRNGR_PAR_MAX_CHUNKS  (512U)
+
+/* Smallest chunk worth handing to another thread */
+#if !defined(STRNGR_PAR_CHUNK_MIN)
+#define STRNGR_PAR_CHUNK_MIN (64U * 1024U)
+#endif
+
+/* Runs fn(arg, i) for every i in [0, count), possibly concurrently, and returns once all calls have finished */
+typedef void (*strngr_par_task_t)(void *arg, const uint32_t index);
+typedef void (*strngr_par_run_t)(void *pool, strngr_par_task_t fn, void *arg, const uint32_t count);
+
+/* Where the chunk tasks run: the library's pool (strngr_par_pool_exec) or the caller's own */
+typedef struct
+{
+    strngr_par_run_t run;
+    void            *pool;
+    uint32_t         threads;
+} strngr_par_exec_t;
+
+typedef struct
+{
+    pthread_mutex_t   lock;
+    pthread_mutex_t   busy;
+    pthread_cond_t    wake;
+    pthread_cond_t    done;
+    pthread_t         workers[STRNGR_PAR_MAX_THREADS];
+    uint32_t          count;
+    uint32_t          shutdown;
+    uint32_t          generation;
+    uint32_t          active;
+    strngr_par_task_t fn;
+    void             *arg;
+    uint32_t          tasks;
+    uint32_t          next;
+} strngr_par_pool_t;
+
+STRNGR_API uint32_t           strngr_par_count(const strngr_par_exec_t *exec, const str_t hay,
+                                               const strngr_needle_t *needle);
+STRNGR_API uint32_t           strngr_par_find_all(const strngr_par_exec_t *exec, const str_t hay,
+                                                  const strngr_needle_t *needle, uint32_t *out, const uint32_t cap);
+STRNGR_API str_t              strngr_par_find_first(const strngr_par_exec_t *exec, const str_t hay,
+                                                    const strngr_needle_t *needle);
+STRNGR_API void               strngr_par_pool_destroy(strngr_par_pool_t *pool);
+STRNGR_API strngr_par_exec_t  strngr_par_pool_exec(strngr_par_pool_t *pool);
+STRNGR_API strngr_par_pool_t *strngr_par_pool_init(strngr_par_pool_t *pool, const uint32_t threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(STRNGR_HEADER_ONLY)
+#include "strngr_par.c"
+#endif
+
+#endif
@@ -35,12 +35,17 @@ void test_strngr_strcspn_null_string(void);
 void test_strngr_strcspn_character_found(void);
 void test_strngr_strcspn_character_not_found(void);
 void test_strngr_strcspn_empty_string(void);
+void test_strngr_strcspn_long_string_every_position(void);
+void test_strngr_strcspn_long_string_not_found(void);
+void test_strngr_strcspn_stops_at_len(void);
+void test_strngr_strcspn_high_bit_character(void);
 
 // strngr_strchr tests
 void test_strngr_strchr_null_string(void);
 void test_strngr_strchr_character_found(void);
 void test_strngr_strchr_character_not_found(void);
 void test_strngr_strchr_first_character(void);
+void test_strngr_strchr_long_string(void);
 
 // strngr_strncpy tests
 void test_strngr_strncpy_null_src_string(void);
@@ -80,6 +85,8 @@ void test_strngr_strncmp_unequal_strings_a_greater(void);
 void test_strngr_strncmp_n_larger_than_a_len(void);
 void test_strngr_strncmp_n_larger_than_b_len(void);
 void test_strngr_strncmp_partial_match(void);
+void test_strngr_strncmp_long_strings_differ_late(void);
+void test_strngr_strncmp_high_bytes_order_unsigned(void);
 
 // strngr_strstr tests
 void test_strngr_strstr_null_haystack(void);
@@ -91,10 +98,15 @@ void test_strngr_strstr_needle_longer_than_haystack(void);
 void test_strngr_strstr_needle_equal_length_haystack(void);
 void test_strngr_strstr_needle_longer_than_haystack_by_one(void);
 void test_strngr_strstr_partial_match_not_found(void);
+void test_strngr_strstr_returns_view_to_end(void);
+void test_strngr_strstr_empty_needle_matches_start(void);
+void test_strngr_strstr_short_needle_in_long_haystack(void);
+void test_strngr_strstr_long_needle_found(void);
+void test_strngr_strstr_adversarial_needle_not_found(void);
 
 // strngr_strsub tests
 void test_strngr_strsub_null_src_string(void);
-void test_strngr_strsub_null_dst_string(void);
+void test_strngr_strsub_view_points_into_src(void);
 void test_strngr_strsub_positive_start_normal(void);
 void test_strngr_strsub_positive_start_at_beginning(void);
 void test_strngr_strsub_positive_start_partial(void);
@@ -107,7 +119,7 @@ void test_strngr_strsub_negative_start_from_end(void);
 void test_strngr_strsub_negative_start_entire_string(void);
 void test_strngr_strsub_negative_start_too_negative(void);
 void test_strngr_strsub_negative_start_length_exceeds_remaining(void);
-void test_strngr_strsub_length_exceeds_dst_max_len(void);
+void test_strngr_strsub_negative_end(void);
 void test_strngr_strsub_zero_length(void);
 void test_strngr_strsub_exact_fit(void);
 void test_strngr_strsub_negative_start_exact_fit(void);
@@ -116,6 +128,182 @@ void test_strngr_strsub_negative_start_single_char_at_end(void);
 void test_strngr_strsub_middle_substring(void);
 void test_strngr_strsub_negative_start_middle_substring(void);
 
+// strngr_strstr_compiled tests
+void test_strngr_needle_compile_null_arguments(void);
+void test_strngr_needle_compile_picks_rare_bytes(void);
+void test_strngr_strstr_compiled_null_needle(void);
+void test_strngr_strstr_compiled_matches_strstr(void);
+void test_strngr_strstr_compiled_reused_across_haystacks(void);
+
+// strngr_multi tests
+void test_strngr_multi_compile_null_arguments(void);
+void test_strngr_multi_mem_required_rejects_empty_pattern(void);
+void test_strngr_multi_arena_too_small(void);
+void test_strngr_multi_find_all_overlapping(void);
+void test_strngr_multi_scan_large_set(void);
+void test_strngr_multi_scan_callback_stops(void);
+void test_strngr_multi_find_all_respects_cap(void);
+void test_strngr_multi_engines_agree_on_order(void);
+void test_strngr_multi_nested_matches_in_start_order(void);
+
+// strngr_new_ex tests
+void test_strngr_new_ex_no_scrub_leaves_buffer(void);
+void test_strngr_new_ex_default_flags_scrub(void);
+void test_strngr_new_s_ex_no_scrub_copies_only(void);
+void test_strngr_new_s_ex_scrubs_tail(void);
+void test_strngr_reset_to_empty_no_scrub(void);
+
+// strngr_cstr tests
+void test_strngr_cstr_null_string(void);
+void test_strngr_cstr_terminated_new_s(void);
+void test_strngr_cstr_terminated_strncat_and_strcat(void);
+void test_strngr_cstr_terminated_strcpy_and_strncpy(void);
+void test_strngr_cstr_reset_terminated(void);
+void test_strngr_cstr_unterminated_string(void);
+void test_strngr_cstr_substring_drops_terminated(void);
+
+// STR_T_LITERAL tests
+void test_str_t_literal_static_initializer(void);
+void test_str_t_literal_matches_from_char(void);
+void test_str_t_literal_empty(void);
+
+// strngr_view tests
+void test_strngr_view_size(void);
+void test_strngr_view_from_str_t(void);
+void test_strngr_view_null_view(void);
+void test_strngr_view_strcspn_and_strchr(void);
+void test_strngr_view_strncmp_matches_str_t(void);
+void test_strngr_view_strstr_and_compiled(void);
+void test_strngr_view_strsub(void);
+
+// strngr_equal tests
+void test_strngr_equal_null_strings(void);
+void test_strngr_equal_same_content(void);
+void test_strngr_equal_different_length(void);
+void test_strngr_equal_different_content(void);
+
+// strngr_new_s_trunc tests
+void test_strngr_new_s_trunc_reports_truncation(void);
+void test_strngr_new_s_trunc_exact_fit(void);
+void test_strngr_new_s_trunc_terminated_reserves_byte(void);
+void test_strngr_new_s_trunc_reads_only_capacity(void);
+void test_strngr_new_s_trunc_null_truncated_pointer(void);
+void test_strngr_new_s_bulk_packs_strings(void);
+void test_strngr_new_s_bulk_stops_when_full(void);
+void test_strngr_new_s_bulk_empty_needs_no_room(void);
+void test_strngr_new_s_bulk_null_arguments(void);
+
+// strngr_arena tests
+void test_strngr_arena_init_null_arguments(void);
+void test_strngr_arena_alloc_alignment(void);
+void test_strngr_arena_alloc_exhausted(void);
+void test_strngr_arena_mark_rewind_reset(void);
+void test_strngr_arena_new_s_packs_terminated(void);
+void test_strngr_arena_new_capacity(void);
+void test_strngr_arena_strcat_grows_in_place(void);
+void test_strngr_arena_strcat_moves_older_string(void);
+void test_strngr_arena_strsub_copies(void);
+
+// strngr_hash tests
+void test_strngr_hash_depends_on_content_only(void);
+void test_strngr_hash_every_length(void);
+void test_strngr_hash_seeded(void);
+void test_strngr_hash_null_is_empty(void);
+
+// strngr_map tests
+void test_strngr_map_init(void);
+void test_strngr_map_put_find(void);
+void test_strngr_map_copies_keys(void);
+void test_strngr_map_remove(void);
+void test_strngr_map_fill_limit(void);
+void test_strngr_map_many_keys(void);
+void test_strngr_map_arena_exhausted(void);
+
+// strngr_intern tests
+void test_strngr_intern_init(void);
+void test_strngr_intern_deduplicates(void);
+void test_strngr_intern_find(void);
+void test_strngr_intern_empty_string(void);
+void test_strngr_intern_full(void);
+
+// strngr_split tests
+void test_strngr_split_init_invalid(void);
+void test_strngr_split_single_byte(void);
+void test_strngr_split_skip_empty(void);
+void test_strngr_split_byte_set(void);
+void test_strngr_split_multi_byte(void);
+void test_strngr_split_quoted(void);
+void test_strngr_split_all(void);
+
+// strngr_lines tests
+void test_strngr_lines_basic(void);
+void test_strngr_lines_trailing_newline(void);
+void test_strngr_lines_strip_cr(void);
+void test_strngr_lines_long_buffer(void);
+void test_strngr_count_lines(void);
+
+// strngr_map_file tests
+void test_strngr_map_file(void);
+void test_strngr_map_file_empty(void);
+void test_strngr_map_file_errors(void);
+void test_strngr_file_window(void);
+
+// strngr_stream tests
+void test_strngr_stream_init(void);
+void test_strngr_stream_across_chunks(void);
+void test_strngr_stream_overlapping(void);
+void test_strngr_stream_multi(void);
+void test_strngr_stream_stop(void);
+
+// strngr_par tests
+void test_strngr_par_serial(void);
+void test_strngr_par_pool(void);
+void test_strngr_par_custom_executor(void);
+void test_strngr_par_no_match(void);
+void test_strngr_par_periodic_needle(void);
+
+// strngr_count tests
+void test_strngr_count_basic(void);
+void test_strngr_count_byte_long(void);
+void test_strngr_find_all_offsets(void);
+void test_strngr_find_all_cap(void);
+void test_strngr_find_all_periodic_needle(void);
+
+// strngr_strrchr / strngr_strrstr tests
+void test_strngr_strrchr_basic(void);
+void test_strngr_strrchr_long_string_every_position(void);
+void test_strngr_strrstr_basic(void);
+void test_strngr_strrstr_matches_naive(void);
+void test_strngr_strrstr_adversarial(void);
+void test_strngr_view_strrchr_and_strrstr(void);
+
+// strngr_byteset_t tests
+void test_strngr_byteset_compile(void);
+void test_strngr_strspn_and_strcspn_set_basic(void);
+void test_strngr_strspn_and_strcspn_set_match_naive(void);
+void test_strngr_view_strspn_strcspn_set_strpbrk(void);
+
+// Case-insensitive tests
+void test_strngr_strncasecmp_basic(void);
+void test_strngr_strncasecmp_long_every_position(void);
+void test_strngr_equal_nocase(void);
+void test_strngr_strcasestr_basic(void);
+void test_strngr_strcasestr_long_and_adversarial(void);
+void test_strngr_hash_nocase(void);
+
+// Case conversion and translation tests
+void test_strngr_to_lower_and_upper_basic(void);
+void test_strngr_to_lower_and_upper_every_byte(void);
+void test_strngr_to_lower_cpy_bounds(void);
+void test_strngr_translate_tr_semantics(void);
+void test_strngr_translate_matches_table(void);
+
+// Trim and collapse tests
+void test_strngr_trim_basic(void);
+void test_strngr_trim_custom_set_and_long_runs(void);
+void test_strngr_collapse_ws_basic(void);
+void test_strngr_collapse_ws_matches_naive(void);
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -151,12 +339,17 @@ int main(void)
     RUN_TEST(test_strngr_strcspn_character_found);
     RUN_TEST(test_strngr_strcspn_character_not_found);
     RUN_TEST(test_strngr_strcspn_empty_string);
+    RUN_TEST(test_strngr_strcspn_long_string_every_position);
+    RUN_TEST(test_strngr_strcspn_long_string_not_found);
+    RUN_TEST(test_strngr_strcspn_stops_at_len);
+    RUN_TEST(test_strngr_strcspn_high_bit_character);
 
     // strngr_strchr tests
     RUN_TEST(test_strngr_strchr_null_string);
     RUN_TEST(test_strngr_strchr_character_found);
     RUN_TEST(test_strngr_strchr_character_not_found);
     RUN_TEST(test_strngr_strchr_first_character);
+    RUN_TEST(test_strngr_strchr_long_string);
 
     // strngr_strncpy tests
     RUN_TEST(test_strngr_strncpy_null_src_string);
@@ -196,6 +389,8 @@ int main(void)
     RUN_TEST(test_strngr_strncmp_n_larger_than_a_len);
     RUN_TEST(test_strngr_strncmp_n_larger_than_b_len);
     RUN_TEST(test_strngr_strncmp_partial_match);
+    RUN_TEST(test_strngr_strncmp_long_strings_differ_late);
+    RUN_TEST(test_strngr_strncmp_high_bytes_order_unsigned);
 
     // strngr_strstr tests
     RUN_TEST(test_strngr_strstr_null_haystack);
@@ -207,10 +402,15 @@ int main(void)
     RUN_TEST(test_strngr_strstr_needle_equal_length_haystack);
     RUN_TEST(test_strngr_strstr_needle_longer_than_haystack_by_one);
     RUN_TEST(test_strngr_strstr_partial_match_not_found);
+    RUN_TEST(test_strngr_strstr_returns_view_to_end);
+    RUN_TEST(test_strngr_strstr_empty_needle_matches_start);
+    RUN_TEST(test_strngr_strstr_short_needle_in_long_haystack);
+    RUN_TEST(test_strngr_strstr_long_needle_found);
+    RUN_TEST(test_strngr_strstr_adversarial_needle_not_found);
 
     // strngr_strsub tests
     RUN_TEST(test_strngr_strsub_null_src_string);
-    RUN_TEST(test_strngr_strsub_null_dst_string);
+    RUN_TEST(test_strngr_strsub_view_points_into_src);
     RUN_TEST(test_strngr_strsub_positive_start_normal);
     RUN_TEST(test_strngr_strsub_positive_start_at_beginning);
     RUN_TEST(test_strngr_strsub_positive_start_partial);
@@ -223,7 +423,7 @@ int main(void)
     RUN_TEST(test_strngr_strsub_negative_start_entire_string);
     RUN_TEST(test_strngr_strsub_negative_start_too_negative);
     RUN_TEST(test_strngr_strsub_negative_start_length_exceeds_remaining);
-    RUN_TEST(test_strngr_strsub_length_exceeds_dst_max_len);
+    RUN_TEST(test_strngr_strsub_negative_end);
     RUN_TEST(test_strngr_strsub_zero_length);
     RUN_TEST(test_strngr_strsub_exact_fit);
     RUN_TEST(test_strngr_strsub_negative_start_exact_fit);
@@ -232,6 +432,182 @@ int main(void)
     RUN_TEST(test_strngr_strsub_middle_substring);
     RUN_TEST(test_strngr_strsub_negative_start_middle_substring);
 
+    // strngr_strstr_compiled tests
+    RUN_TEST(test_strngr_needle_compile_null_arguments);
+    RUN_TEST(test_strngr_needle_compile_picks_rare_bytes);
+    RUN_TEST(test_strngr_strstr_compiled_null_needle);
+    RUN_TEST(test_strngr_strstr_compiled_matches_strstr);
+    RUN_TEST(test_strngr_strstr_compiled_reused_across_haystacks);
+
+    // strngr_multi tests
+    RUN_TEST(test_strngr_multi_compile_null_arguments);
+    RUN_TEST(test_strngr_multi_mem_required_rejects_empty_pattern);
+    RUN_TEST(test_strngr_multi_arena_too_small);
+    RUN_TEST(test_strngr_multi_find_all_overlapping);
+    RUN_TEST(test_strngr_multi_scan_large_set);
+    RUN_TEST(test_strngr_multi_scan_callback_stops);
+    RUN_TEST(test_strngr_multi_find_all_respects_cap);
+    RUN_TEST(test_strngr_multi_engines_agree_on_order);
+    RUN_TEST(test_strngr_multi_nested_matches_in_start_order);
+
+    // strngr_new_ex tests
+    RUN_TEST(test_strngr_new_ex_no_scrub_leaves_buffer);
+    RUN_TEST(test_strngr_new_ex_default_flags_scrub);
+    RUN_TEST(test_strngr_new_s_ex_no_scrub_copies_only);
+    RUN_TEST(test_strngr_new_s_ex_scrubs_tail);
+    RUN_TEST(test_strngr_reset_to_empty_no_scrub);
+
+    // strngr_cstr tests
+    RUN_TEST(test_strngr_cstr_null_string);
+    RUN_TEST(test_strngr_cstr_terminated_new_s);
+    RUN_TEST(test_strngr_cstr_terminated_strncat_and_strcat);
+    RUN_TEST(test_strngr_cstr_terminated_strcpy_and_strncpy);
+    RUN_TEST(test_strngr_cstr_reset_terminated);
+    RUN_TEST(test_strngr_cstr_unterminated_string);
+    RUN_TEST(test_strngr_cstr_substring_drops_terminated);
+
+    // STR_T_LITERAL tests
+    RUN_TEST(test_str_t_literal_static_initializer);
+    RUN_TEST(test_str_t_literal_matches_from_char);
+    RUN_TEST(test_str_t_literal_empty);
+
+    // strngr_view tests
+    RUN_TEST(test_strngr_view_size);
+    RUN_TEST(test_strngr_view_from_str_t);
+    RUN_TEST(test_strngr_view_null_view);
+    RUN_TEST(test_strngr_view_strcspn_and_strchr);
+    RUN_TEST(test_strngr_view_strncmp_matches_str_t);
+    RUN_TEST(test_strngr_view_strstr_and_compiled);
+    RUN_TEST(test_strngr_view_strsub);
+
+    // strngr_equal tests
+    RUN_TEST(test_strngr_equal_null_strings);
+    RUN_TEST(test_strngr_equal_same_content);
+    RUN_TEST(test_strngr_equal_different_length);
+    RUN_TEST(test_strngr_equal_different_content);
+
+    // strngr_new_s_trunc tests
+    RUN_TEST(test_strngr_new_s_trunc_reports_truncation);
+    RUN_TEST(test_strngr_new_s_trunc_exact_fit);
+    RUN_TEST(test_strngr_new_s_trunc_terminated_reserves_byte);
+    RUN_TEST(test_strngr_new_s_trunc_reads_only_capacity);
+    RUN_TEST(test_strngr_new_s_trunc_null_truncated_pointer);
+    RUN_TEST(test_strngr_new_s_bulk_packs_strings);
+    RUN_TEST(test_strngr_new_s_bulk_stops_when_full);
+    RUN_TEST(test_strngr_new_s_bulk_empty_needs_no_room);
+    RUN_TEST(test_strngr_new_s_bulk_null_arguments);
+
+    // strngr_arena tests
+    RUN_TEST(test_strngr_arena_init_null_arguments);
+    RUN_TEST(test_strngr_arena_alloc_alignment);
+    RUN_TEST(test_strngr_arena_alloc_exhausted);
+    RUN_TEST(test_strngr_arena_mark_rewind_reset);
+    RUN_TEST(test_strngr_arena_new_s_packs_terminated);
+    RUN_TEST(test_strngr_arena_new_capacity);
+    RUN_TEST(test_strngr_arena_strcat_grows_in_place);
+    RUN_TEST(test_strngr_arena_strcat_moves_older_string);
+    RUN_TEST(test_strngr_arena_strsub_copies);
+
+    // strngr_hash tests
+    RUN_TEST(test_strngr_hash_depends_on_content_only);
+    RUN_TEST(test_strngr_hash_every_length);
+    RUN_TEST(test_strngr_hash_seeded);
+    RUN_TEST(test_strngr_hash_null_is_empty);
+
+    // strngr_map tests
+    RUN_TEST(test_strngr_map_init);
+    RUN_TEST(test_strngr_map_put_find);
+    RUN_TEST(test_strngr_map_copies_keys);
+    RUN_TEST(test_strngr_map_remove);
+    RUN_TEST(test_strngr_map_fill_limit);
+    RUN_TEST(test_strngr_map_many_keys);
+    RUN_TEST(test_strngr_map_arena_exhausted);
+
+    // strngr_intern tests
+    RUN_TEST(test_strngr_intern_init);
+    RUN_TEST(test_strngr_intern_deduplicates);
+    RUN_TEST(test_strngr_intern_find);
+    RUN_TEST(test_strngr_intern_empty_string);
+    RUN_TEST(test_strngr_intern_full);
+
+    // strngr_split tests
+    RUN_TEST(test_strngr_split_init_invalid);
+    RUN_TEST(test_strngr_split_single_byte);
+    RUN_TEST(test_strngr_split_skip_empty);
+    RUN_TEST(test_strngr_split_byte_set);
+    RUN_TEST(test_strngr_split_multi_byte);
+    RUN_TEST(test_strngr_split_quoted);
+    RUN_TEST(test_strngr_split_all);
+
+    // strngr_lines tests
+    RUN_TEST(test_strngr_lines_basic);
+    RUN_TEST(test_strngr_lines_trailing_newline);
+    RUN_TEST(test_strngr_lines_strip_cr);
+    RUN_TEST(test_strngr_lines_long_buffer);
+    RUN_TEST(test_strngr_count_lines);
+
+    // strngr_map_file tests
+    RUN_TEST(test_strngr_map_file);
+    RUN_TEST(test_strngr_map_file_empty);
+    RUN_TEST(test_strngr_map_file_errors);
+    RUN_TEST(test_strngr_file_window);
+
+    // strngr_stream tests
+    RUN_TEST(test_strngr_stream_init);
+    RUN_TEST(test_strngr_stream_across_chunks);
+    RUN_TEST(test_strngr_stream_overlapping);
+    RUN_TEST(test_strngr_stream_multi);
+    RUN_TEST(test_strngr_stream_stop);
+
+    // strngr_par tests
+    RUN_TEST(test_strngr_par_serial);
+    RUN_TEST(test_strngr_par_pool);
+    RUN_TEST(test_strngr_par_custom_executor);
+    RUN_TEST(test_strngr_par_no_match);
+    RUN_TEST(test_strngr_par_periodic_needle);
+
+    // strngr_count tests
+    RUN_TEST(test_strngr_count_basic);
+    RUN_TEST(test_strngr_count_byte_long);
+    RUN_TEST(test_strngr_find_all_offsets);
+    RUN_TEST(test_strngr_find_all_cap);
+    RUN_TEST(test_strngr_find_all_periodic_needle);
+
+    // strngr_strrchr / strngr_strrstr tests
+    RUN_TEST(test_strngr_strrchr_basic);
+    RUN_TEST(test_strngr_strrchr_long_string_every_position);
+    RUN_TEST(test_strngr_strrstr_basic);
+    RUN_TEST(test_strngr_strrstr_matches_naive);
+    RUN_TEST(test_strngr_strrstr_adversarial);
+    RUN_TEST(test_strngr_view_strrchr_and_strrstr);
+
+    // strngr_byteset_t tests
+    RUN_TEST(test_strngr_byteset_compile);
+    RUN_TEST(test_strngr_strspn_and_strcspn_set_basic);
+    RUN_TEST(test_strngr_strspn_and_strcspn_set_match_naive);
+    RUN_TEST(test_strngr_view_strspn_strcspn_set_strpbrk);
+
+    // Case-insensitive tests
+    RUN_TEST(test_strngr_strncasecmp_basic);
+    RUN_TEST(test_strngr_strncasecmp_long_every_position);
+    RUN_TEST(test_strngr_equal_nocase);
+    RUN_TEST(test_strngr_strcasestr_basic);
+    RUN_TEST(test_strngr_strcasestr_long_and_adversarial);
+    RUN_TEST(test_strngr_hash_nocase);
+
+    // Case conversion and translation tests
+    RUN_TEST(test_strngr_to_lower_and_upper_basic);
+    RUN_TEST(test_strngr_to_lower_and_upper_every_byte);
+    RUN_TEST(test_strngr_to_lower_cpy_bounds);
+    RUN_TEST(test_strngr_translate_tr_semantics);
+    RUN_TEST(test_strngr_translate_matches_table);
+
+    // Trim and collapse tests
+    RUN_TEST(test_strngr_trim_basic);
+    RUN_TEST(test_strngr_trim_custom_set_and_long_runs);
+    RUN_TEST(test_strngr_collapse_ws_basic);
+    RUN_TEST(test_strngr_collapse_ws_matches_naive);
+
     return UNITY_END();
 }
 
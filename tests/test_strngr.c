@@ -1,5 +1,8 @@
 #include "unity.h"
 #include "../strngr.h"
+#include "../strngr_file.h"
+#include "../strngr_par.h"
+#include <stdio.h>
 #include <string.h>
 #include <stdint.h>
 
@@ -60,12 +63,15 @@ void test_strngr_new_valid_initialization(void)
     TEST_ASSERT_EQUAL_UINT32(0, str.len);
     TEST_ASSERT_EQUAL_UINT32(10, str.max_len);
     TEST_ASSERT_EQUAL_PTR(mem, str.str);
-    TEST_ASSERT_EQUAL_UINT32(0, str.term);
+    TEST_ASSERT_EQUAL_UINT32(STRNGR_DEFAULT_FLAGS, str.term);
     
-    // Verify memory is zeroed
-    for (uint32_t i = 0; i < 10; i++)
+    // Verify memory is zeroed, unless the build turned scrubbing off by default
+    if ((STRNGR_DEFAULT_FLAGS & STRNGR_FLAG_NO_SCRUB) == 0U)
     {
-        TEST_ASSERT_EQUAL(0, mem[i]);
+        for (uint32_t i = 0; i < 10; i++)
+        {
+            TEST_ASSERT_EQUAL(0, mem[i]);
+        }
     }
 }
 
@@ -75,44 +81,44 @@ void test_strngr_new_valid_initialization(void)
 
 void test_strngr_new_s_null_str_pointer(void)
 {
-    char mem[10];
-    TEST_ASSERT_NULL(strngr_new_s(NULL, mem, 10, "test"));
+    // The result is returned by value, so only the buffer and source can be missing
+    str_t str = strngr_new_s(NULL, 10, NULL);
+    TEST_ASSERT_NULL(str.str);
+    TEST_ASSERT_EQUAL_UINT32(0, str.max_len);
 }
 
 void test_strngr_new_s_null_mem_pointer(void)
 {
-    str_t str;
-    TEST_ASSERT_NULL(strngr_new_s(&str, NULL, 10, "test"));
+    str_t str = strngr_new_s(NULL, 10, "test");
+    TEST_ASSERT_NULL(str.str);
+    TEST_ASSERT_EQUAL_UINT32(0, str.len);
 }
 
 void test_strngr_new_s_null_string_pointer(void)
 {
     char mem[10];
-    str_t str;
-    TEST_ASSERT_NULL(strngr_new_s(&str, mem, 10, NULL));
+    str_t str = strngr_new_s(mem, 10, NULL);
+    TEST_ASSERT_NULL(str.str);
 }
 
 void test_strngr_new_s_zero_length(void)
 {
     char mem[10];
-    str_t str;
-    TEST_ASSERT_NULL(strngr_new_s(&str, mem, 0, "test"));
+    str_t str = strngr_new_s(mem, 0, "test");
+    TEST_ASSERT_NULL(str.str);
 }
 
 void test_strngr_new_s_valid_string_copy(void)
 {
     char mem[20];
-    str_t str;
     const char *input = "Hello";
-    char *result = strngr_new_s(&str, mem, 20, input);
-    
-    TEST_ASSERT_NOT_NULL(result);
-    TEST_ASSERT_EQUAL_PTR(mem, result);
+    str_t str = strngr_new_s(mem, 20, input);
+
+    TEST_ASSERT_EQUAL_PTR(mem, str.str);
     TEST_ASSERT_EQUAL_UINT32(strlen(input), str.len);
     TEST_ASSERT_EQUAL_UINT32(20, str.max_len);
-    TEST_ASSERT_EQUAL_PTR(mem, str.str);
-    TEST_ASSERT_EQUAL_UINT32(0, str.term);
-    
+    TEST_ASSERT_EQUAL_UINT32(STRNGR_DEFAULT_FLAGS, str.term);
+
     // Verify string was copied
     TEST_ASSERT_EQUAL_MEMORY(input, mem, strlen(input));
 }
@@ -120,11 +126,10 @@ void test_strngr_new_s_valid_string_copy(void)
 void test_strngr_new_s_string_longer_than_buffer(void)
 {
     char mem[5];
-    str_t str;
     const char *input = "Hello World";
-    char *result = strngr_new_s(&str, mem, 5, input);
-    
-    TEST_ASSERT_NOT_NULL(result);
+    str_t str = strngr_new_s(mem, 5, input);
+
+    TEST_ASSERT_NOT_NULL(str.str);
     // Should only copy first 5 characters
     TEST_ASSERT_EQUAL_UINT32(5, str.len);
     TEST_ASSERT_EQUAL_MEMORY("Hello", mem, 5);
@@ -143,7 +148,7 @@ void test_strngr_reset_to_empty_null_pointer(void)
 
 void test_strngr_reset_to_empty_valid_string(void)
 {
-    strngr_new(&str1, buffer1, sizeof(buffer1));
+    strngr_new_ex(&str1, buffer1, sizeof(buffer1), 0U);
     str1.len = 0;
     
     strngr_reset_to_empty(&str1);
@@ -158,7 +163,8 @@ void test_strngr_reset_to_empty_valid_string(void)
 
 void test_strngr_reset_to_empty_string_with_content(void)
 {
-    strngr_new(&str1, buffer1, sizeof(buffer1));
+    // Scrubbing explicitly, so the build's default flags do not matter
+    strngr_new_ex(&str1, buffer1, sizeof(buffer1), 0U);
     strcpy(buffer1, "Hello World");
     str1.len = 11;
     
@@ -174,7 +180,7 @@ void test_strngr_reset_to_empty_string_with_content(void)
 
 void test_strngr_reset_to_empty_partially_filled_buffer(void)
 {
-    strngr_new(&str1, buffer1, sizeof(buffer1));
+    strngr_new_ex(&str1, buffer1, sizeof(buffer1), 0U);
     strcpy(buffer1, "Test");
     str1.len = 4;
     
@@ -267,6 +273,49 @@ void test_strngr_strcspn_empty_string(void)
     TEST_ASSERT_EQUAL_UINT32(0, strngr_strcspn(str1, 'a'));
 }
 
+void test_strngr_strcspn_long_string_every_position(void)
+{
+    char mem[200];
+    str_t str = {sizeof(mem), sizeof(mem), mem, 0U};
+
+    for (uint32_t pos = 0; pos < sizeof(mem); pos++)
+    {
+        memset(mem, 'a', sizeof(mem));
+        mem[pos] = ';';
+        TEST_ASSERT_EQUAL_UINT32(pos, strngr_strcspn(str, ';'));
+    }
+}
+
+void test_strngr_strcspn_long_string_not_found(void)
+{
+    char mem[200];
+    memset(mem, 'a', sizeof(mem));
+    str_t str = {sizeof(mem), sizeof(mem), mem, 0U};
+
+    TEST_ASSERT_EQUAL_UINT32(200, strngr_strcspn(str, ';'));
+}
+
+void test_strngr_strcspn_stops_at_len(void)
+{
+    char mem[100];
+    memset(mem, 'a', sizeof(mem));
+    mem[70] = ';';
+    str_t str = {sizeof(mem), 70, mem, 0U};
+
+    // Match lies just beyond len so must not be reported
+    TEST_ASSERT_EQUAL_UINT32(70, strngr_strcspn(str, ';'));
+}
+
+void test_strngr_strcspn_high_bit_character(void)
+{
+    char mem[40];
+    memset(mem, 0x7F, sizeof(mem));
+    mem[33] = (char)0xFF;
+    str_t str = {sizeof(mem), sizeof(mem), mem, 0U};
+
+    TEST_ASSERT_EQUAL_UINT32(33, strngr_strcspn(str, (char)0xFF));
+}
+
 // ============================================================================
 // Tests for strngr_strchr
 // ============================================================================
@@ -311,6 +360,18 @@ void test_strngr_strchr_first_character(void)
     TEST_ASSERT_EQUAL_PTR(&buffer1[0], result);
 }
 
+void test_strngr_strchr_long_string(void)
+{
+    char mem[150];
+    memset(mem, 'x', sizeof(mem));
+    mem[97] = '\n';
+    mem[130] = '\n';
+    str_t str = {sizeof(mem), sizeof(mem), mem, 0U};
+
+    char *result = strngr_strchr(str, '\n');
+    TEST_ASSERT_EQUAL_PTR(&mem[97], result);
+}
+
 // ============================================================================
 // Tests for strngr_strncpy
 // ============================================================================
@@ -734,6 +795,39 @@ void test_strngr_strncmp_partial_match(void)
     TEST_ASSERT_NOT_EQUAL_INT32(0, strngr_strncmp(str1, str2, 4));
 }
 
+void test_strngr_strncmp_long_strings_differ_late(void)
+{
+    char a[100];
+    char b[100];
+    memset(a, 'k', sizeof(a));
+    memset(b, 'k', sizeof(b));
+    str_t sa = {sizeof(a), sizeof(a), a, 0U};
+    str_t sb = {sizeof(b), sizeof(b), b, 0U};
+
+    TEST_ASSERT_EQUAL_INT32(0, strngr_strncmp(sa, sb, 100));
+
+    for (uint32_t pos = 0; pos < sizeof(a); pos += 7)
+    {
+        memset(b, 'k', sizeof(b));
+        b[pos] = 'm';
+        TEST_ASSERT_LESS_THAN_INT32(0, strngr_strncmp(sa, sb, 100));
+        TEST_ASSERT_GREATER_THAN_INT32(0, strngr_strncmp(sb, sa, 100));
+        TEST_ASSERT_EQUAL_INT32(0, strngr_strncmp(sa, sb, pos));
+    }
+}
+
+void test_strngr_strncmp_high_bytes_order_unsigned(void)
+{
+    char a[1] = {(char)0x80};
+    char b[1] = {'a'};
+    str_t sa = {1, 1, a, 0U};
+    str_t sb = {1, 1, b, 0U};
+
+    // 0x80 sorts after 'a' regardless of the signedness of char
+    TEST_ASSERT_GREATER_THAN_INT32(0, strngr_strncmp(sa, sb, 1));
+    TEST_ASSERT_LESS_THAN_INT32(0, strngr_strncmp(sb, sa, 1));
+}
+
 // ============================================================================
 // Tests for strngr_strstr
 // ============================================================================
@@ -748,7 +842,7 @@ void test_strngr_strstr_null_haystack(void)
     hay.str = NULL;
     hay.len = 0;
     
-    TEST_ASSERT_NULL(strngr_strstr(hay, str1));
+    TEST_ASSERT_NULL(strngr_strstr(hay, str1).str);
 }
 
 void test_strngr_strstr_null_needle(void)
@@ -761,7 +855,7 @@ void test_strngr_strstr_null_needle(void)
     needle.str = NULL;
     needle.len = 0;
     
-    TEST_ASSERT_NULL(strngr_strstr(str1, needle));
+    TEST_ASSERT_NULL(strngr_strstr(str1, needle).str);
 }
 
 void test_strngr_strstr_needle_found(void)
@@ -774,7 +868,7 @@ void test_strngr_strstr_needle_found(void)
     strcpy(buffer2, "World");
     str2.len = 5;
     
-    char *result = strngr_strstr(str1, str2);
+    char *result = strngr_strstr(str1, str2).str;
     TEST_ASSERT_NOT_NULL(result);
     TEST_ASSERT_EQUAL_PTR(&buffer1[6], result);
     TEST_ASSERT_EQUAL_MEMORY("World", result, 5);
@@ -790,7 +884,7 @@ void test_strngr_strstr_needle_not_found(void)
     strcpy(buffer2, "Test");
     str2.len = 4;
     
-    TEST_ASSERT_NULL(strngr_strstr(str1, str2));
+    TEST_ASSERT_NULL(strngr_strstr(str1, str2).str);
 }
 
 void test_strngr_strstr_needle_at_start(void)
@@ -803,7 +897,7 @@ void test_strngr_strstr_needle_at_start(void)
     strcpy(buffer2, "Hello");
     str2.len = 5;
     
-    char *result = strngr_strstr(str1, str2);
+    char *result = strngr_strstr(str1, str2).str;
     TEST_ASSERT_NOT_NULL(result);
     TEST_ASSERT_EQUAL_PTR(&buffer1[0], result);
 }
@@ -818,7 +912,7 @@ void test_strngr_strstr_needle_longer_than_haystack(void)
     strcpy(buffer2, "Hello");
     str2.len = 5;
     
-    TEST_ASSERT_NULL(strngr_strstr(str1, str2));
+    TEST_ASSERT_NULL(strngr_strstr(str1, str2).str);
 }
 
 void test_strngr_strstr_needle_equal_length_haystack(void)
@@ -831,7 +925,7 @@ void test_strngr_strstr_needle_equal_length_haystack(void)
     strcpy(buffer2, "Hello");
     str2.len = 5;
     
-    char *result = strngr_strstr(str1, str2);
+    char *result = strngr_strstr(str1, str2).str;
     TEST_ASSERT_NOT_NULL(result);
     TEST_ASSERT_EQUAL_PTR(&buffer1[0], result);
 }
@@ -846,7 +940,7 @@ void test_strngr_strstr_needle_longer_than_haystack_by_one(void)
     strcpy(buffer2, "Hello!");
     str2.len = 6;
     
-    TEST_ASSERT_NULL(strngr_strstr(str1, str2));
+    TEST_ASSERT_NULL(strngr_strstr(str1, str2).str);
 }
 
 void test_strngr_strstr_partial_match_not_found(void)
@@ -859,41 +953,107 @@ void test_strngr_strstr_partial_match_not_found(void)
     strcpy(buffer2, "Worlx");
     str2.len = 5;
     
-    TEST_ASSERT_NULL(strngr_strstr(str1, str2));
+    TEST_ASSERT_NULL(strngr_strstr(str1, str2).str);
+}
+
+void test_strngr_strstr_returns_view_to_end(void)
+{
+    char hay[] = "key=value; next=1";
+    str_t h = {17, 17, hay, 0U};
+    str_t n = {2, 2, "; ", 0U};
+
+    str_t result = strngr_strstr(h, n);
+    TEST_ASSERT_EQUAL_PTR(&hay[9], result.str);
+    TEST_ASSERT_EQUAL_UINT32(8, result.len);
+    TEST_ASSERT_EQUAL_UINT32(8, result.max_len);
+}
+
+void test_strngr_strstr_empty_needle_matches_start(void)
+{
+    char hay[] = "abc";
+    str_t h = {3, 3, hay, 0U};
+    str_t n = {0, 0, "", 0U};
+
+    str_t result = strngr_strstr(h, n);
+    TEST_ASSERT_EQUAL_PTR(hay, result.str);
+    TEST_ASSERT_EQUAL_UINT32(3, result.len);
+}
+
+void test_strngr_strstr_short_needle_in_long_haystack(void)
+{
+    char hay[300];
+    memset(hay, 'a', sizeof(hay));
+    memcpy(&hay[250], "needle", 6);
+    str_t h = {sizeof(hay), sizeof(hay), hay, 0U};
+    str_t n = {6, 6, "needle", 0U};
+
+    str_t result = strngr_strstr(h, n);
+    TEST_ASSERT_EQUAL_PTR(&hay[250], result.str);
+    TEST_ASSERT_EQUAL_UINT32(50, result.len);
+}
+
+void test_strngr_strstr_long_needle_found(void)
+{
+    char hay[400];
+    char needle[64];
+    for (uint32_t i = 0; i < sizeof(hay); i++)
+    {
+        hay[i] = (char)('a' + (i % 7));
+    }
+    memcpy(needle, &hay[301], sizeof(needle));
+    str_t h = {sizeof(hay), sizeof(hay), hay, 0U};
+    str_t n = {sizeof(needle), sizeof(needle), needle, 0U};
+
+    // Period of the haystack is 7 so the first match is at 301 % 7
+    str_t result = strngr_strstr(h, n);
+    TEST_ASSERT_EQUAL_PTR(&hay[301 % 7], result.str);
+}
+
+void test_strngr_strstr_adversarial_needle_not_found(void)
+{
+    static char hay[4096];
+    char needle[48];
+    memset(hay, 'a', sizeof(hay));
+    memset(needle, 'a', sizeof(needle));
+    needle[sizeof(needle) - 1] = 'b';
+    str_t h = {sizeof(hay), sizeof(hay), hay, 0U};
+    str_t n = {sizeof(needle), sizeof(needle), needle, 0U};
+
+    TEST_ASSERT_NULL(strngr_strstr(h, n).str);
+
+    // Short periodic needle with the mismatch in the middle
+    needle[sizeof(needle) - 1] = 'a';
+    needle[5] = 'b';
+    n.len = 12;
+    TEST_ASSERT_NULL(strngr_strstr(h, n).str);
 }
 
 // ============================================================================
 // Tests for strngr_strsub
 // ============================================================================
-
 void test_strngr_strsub_null_src_string(void)
 {
-    strngr_new(&str1, buffer1, sizeof(buffer1));
     str_t src;
     src.str = NULL;
     src.len = 0;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    strcpy(buffer2, "test");
-    str2.len = 4;
-    
-    strngr_strsub(&str2, src, 0, 2);
-    // Should not modify destination
-    TEST_ASSERT_EQUAL_UINT32(4, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("test", buffer2, 4);
+
+    str_t sub = strngr_strsub(src, 0, 2);
+    TEST_ASSERT_NULL(sub.str);
+    TEST_ASSERT_EQUAL_UINT32(0, sub.len);
 }
 
-void test_strngr_strsub_null_dst_string(void)
+void test_strngr_strsub_view_points_into_src(void)
 {
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    str_t dst;
-    dst.str = NULL;
-    
-    strngr_strsub(&dst, str1, 0, 2);
-    // Should not crash
+
+    str_t sub = strngr_strsub(str1, 1, 3);
+
+    // A view shares the source buffer and cannot grow past its own length
+    TEST_ASSERT_EQUAL_PTR(&buffer1[1], sub.str);
+    TEST_ASSERT_EQUAL_UINT32(2, sub.len);
+    TEST_ASSERT_EQUAL_UINT32(2, sub.max_len);
 }
 
 void test_strngr_strsub_positive_start_normal(void)
@@ -901,13 +1061,12 @@ void test_strngr_strsub_positive_start_normal(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello World");
     str1.len = 11;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, 6, 5);
-    
-    TEST_ASSERT_EQUAL_UINT32(5, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("World", buffer2, 5);
+
+    str_t sub = strngr_strsub(str1, 6, 11);
+
+    TEST_ASSERT_EQUAL_UINT32(5, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[6], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("World", sub.str, 5);
 }
 
 void test_strngr_strsub_positive_start_at_beginning(void)
@@ -915,13 +1074,12 @@ void test_strngr_strsub_positive_start_at_beginning(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, 0, 5);
-    
-    TEST_ASSERT_EQUAL_UINT32(5, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("Hello", buffer2, 5);
+
+    str_t sub = strngr_strsub(str1, 0, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(5, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[0], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("Hello", sub.str, 5);
 }
 
 void test_strngr_strsub_positive_start_partial(void)
@@ -929,13 +1087,12 @@ void test_strngr_strsub_positive_start_partial(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello World");
     str1.len = 11;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, 0, 5);
-    
-    TEST_ASSERT_EQUAL_UINT32(5, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("Hello", buffer2, 5);
+
+    str_t sub = strngr_strsub(str1, 0, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(5, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[0], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("Hello", sub.str, 5);
 }
 
 void test_strngr_strsub_positive_start_single_char(void)
@@ -943,13 +1100,12 @@ void test_strngr_strsub_positive_start_single_char(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, 2, 1);
-    
-    TEST_ASSERT_EQUAL_UINT32(1, str2.len);
-    TEST_ASSERT_EQUAL('l', buffer2[0]);
+
+    str_t sub = strngr_strsub(str1, 2, 3);
+
+    TEST_ASSERT_EQUAL_UINT32(1, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[2], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("l", sub.str, 1);
 }
 
 void test_strngr_strsub_positive_start_out_of_bounds(void)
@@ -957,15 +1113,12 @@ void test_strngr_strsub_positive_start_out_of_bounds(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    strcpy(buffer2, "test");
-    str2.len = 4;
-    
-    strngr_strsub(&str2, str1, 10, 2);
-    // Should not modify destination
-    TEST_ASSERT_EQUAL_UINT32(4, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("test", buffer2, 4);
+
+    // Start past the end gives an empty view
+    str_t sub = strngr_strsub(str1, 10, 12);
+
+    TEST_ASSERT_NULL(sub.str);
+    TEST_ASSERT_EQUAL_UINT32(0, sub.len);
 }
 
 void test_strngr_strsub_positive_start_length_exceeds_remaining(void)
@@ -973,15 +1126,13 @@ void test_strngr_strsub_positive_start_length_exceeds_remaining(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    strcpy(buffer2, "test");
-    str2.len = 4;
-    
-    strngr_strsub(&str2, str1, 3, 5); // length 5 but only 2 chars remain
-    // Should not modify destination
-    TEST_ASSERT_EQUAL_UINT32(4, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("test", buffer2, 4);
+
+    // End is clamped to the source length
+    str_t sub = strngr_strsub(str1, 3, 8);
+
+    TEST_ASSERT_EQUAL_UINT32(2, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[3], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("lo", sub.str, 2);
 }
 
 void test_strngr_strsub_negative_start_minus_one(void)
@@ -989,13 +1140,12 @@ void test_strngr_strsub_negative_start_minus_one(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, -1, 1);
-    
-    TEST_ASSERT_EQUAL_UINT32(1, str2.len);
-    TEST_ASSERT_EQUAL('o', buffer2[0]);
+
+    str_t sub = strngr_strsub(str1, -1, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(1, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[4], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("o", sub.str, 1);
 }
 
 void test_strngr_strsub_negative_start_minus_two(void)
@@ -1003,13 +1153,12 @@ void test_strngr_strsub_negative_start_minus_two(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, -2, 2);
-    
-    TEST_ASSERT_EQUAL_UINT32(2, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("lo", buffer2, 2);
+
+    str_t sub = strngr_strsub(str1, -2, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(2, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[3], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("lo", sub.str, 2);
 }
 
 void test_strngr_strsub_negative_start_from_end(void)
@@ -1017,13 +1166,12 @@ void test_strngr_strsub_negative_start_from_end(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello World");
     str1.len = 11;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, -5, 5);
-    
-    TEST_ASSERT_EQUAL_UINT32(5, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("World", buffer2, 5);
+
+    str_t sub = strngr_strsub(str1, -5, 11);
+
+    TEST_ASSERT_EQUAL_UINT32(5, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[6], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("World", sub.str, 5);
 }
 
 void test_strngr_strsub_negative_start_entire_string(void)
@@ -1031,13 +1179,12 @@ void test_strngr_strsub_negative_start_entire_string(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, -5, 5);
-    
-    TEST_ASSERT_EQUAL_UINT32(5, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("Hello", buffer2, 5);
+
+    str_t sub = strngr_strsub(str1, -5, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(5, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[0], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("Hello", sub.str, 5);
 }
 
 void test_strngr_strsub_negative_start_too_negative(void)
@@ -1045,15 +1192,13 @@ void test_strngr_strsub_negative_start_too_negative(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    strcpy(buffer2, "test");
-    str2.len = 4;
-    
-    strngr_strsub(&str2, str1, -10, 2);
-    // Should not modify destination (start would be -5, invalid)
-    TEST_ASSERT_EQUAL_UINT32(4, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("test", buffer2, 4);
+
+    // Start before the beginning is clamped to 0
+    str_t sub = strngr_strsub(str1, -10, 2);
+
+    TEST_ASSERT_EQUAL_UINT32(2, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[0], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("He", sub.str, 2);
 }
 
 void test_strngr_strsub_negative_start_length_exceeds_remaining(void)
@@ -1061,32 +1206,26 @@ void test_strngr_strsub_negative_start_length_exceeds_remaining(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    strcpy(buffer2, "test");
-    str2.len = 4;
-    
-    strngr_strsub(&str2, str1, -3, 5); // length 5 but only 3 chars remain
-    // Should not modify destination
-    TEST_ASSERT_EQUAL_UINT32(4, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("test", buffer2, 4);
+
+    str_t sub = strngr_strsub(str1, -3, 100);
+
+    TEST_ASSERT_EQUAL_UINT32(3, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[2], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("llo", sub.str, 3);
 }
 
-void test_strngr_strsub_length_exceeds_dst_max_len(void)
+void test_strngr_strsub_negative_end(void)
 {
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello World");
     str1.len = 11;
-    
-    strngr_new(&str2, buffer2, 5); // max_len = 5
-    
-    strcpy(buffer2, "test");
-    str2.len = 4;
-    
-    strngr_strsub(&str2, str1, 0, 10); // length 10 > dst max_len 5
-    // Should not modify destination
-    TEST_ASSERT_EQUAL_UINT32(4, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("test", buffer2, 4);
+
+    // Negative end counts from the end as well
+    str_t sub = strngr_strsub(str1, 0, -6);
+
+    TEST_ASSERT_EQUAL_UINT32(5, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[0], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("Hello", sub.str, 5);
 }
 
 void test_strngr_strsub_zero_length(void)
@@ -1094,14 +1233,12 @@ void test_strngr_strsub_zero_length(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    strcpy(buffer2, "test");
-    str2.len = 4;
-    
-    strngr_strsub(&str2, str1, 0, 0);
-    
-    TEST_ASSERT_EQUAL_UINT32(0, str2.len);
+
+    // start == end is empty
+    str_t sub = strngr_strsub(str1, 0, 0);
+
+    TEST_ASSERT_NULL(sub.str);
+    TEST_ASSERT_EQUAL_UINT32(0, sub.len);
 }
 
 void test_strngr_strsub_exact_fit(void)
@@ -1109,13 +1246,12 @@ void test_strngr_strsub_exact_fit(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, 5); // max_len = 5
-    
-    strngr_strsub(&str2, str1, 0, 5);
-    
-    TEST_ASSERT_EQUAL_UINT32(5, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("Hello", buffer2, 5);
+
+    str_t sub = strngr_strsub(str1, 0, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(5, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[0], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("Hello", sub.str, 5);
 }
 
 void test_strngr_strsub_negative_start_exact_fit(void)
@@ -1123,13 +1259,12 @@ void test_strngr_strsub_negative_start_exact_fit(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, 3); // max_len = 3
-    
-    strngr_strsub(&str2, str1, -3, 3);
-    
-    TEST_ASSERT_EQUAL_UINT32(3, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("llo", buffer2, 3);
+
+    str_t sub = strngr_strsub(str1, -3, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(3, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[2], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("llo", sub.str, 3);
 }
 
 void test_strngr_strsub_positive_start_at_end(void)
@@ -1137,15 +1272,12 @@ void test_strngr_strsub_positive_start_at_end(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    strcpy(buffer2, "test");
-    str2.len = 4;
-    
-    strngr_strsub(&str2, str1, 5, 1);
-    // Should not modify (start equals length, out of bounds)
-    TEST_ASSERT_EQUAL_UINT32(4, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("test", buffer2, 4);
+
+    // Start equal to the length is out of bounds
+    str_t sub = strngr_strsub(str1, 5, 6);
+
+    TEST_ASSERT_NULL(sub.str);
+    TEST_ASSERT_EQUAL_UINT32(0, sub.len);
 }
 
 void test_strngr_strsub_negative_start_single_char_at_end(void)
@@ -1153,13 +1285,12 @@ void test_strngr_strsub_negative_start_single_char_at_end(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello");
     str1.len = 5;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, -1, 1);
-    
-    TEST_ASSERT_EQUAL_UINT32(1, str2.len);
-    TEST_ASSERT_EQUAL('o', buffer2[0]);
+
+    str_t sub = strngr_strsub(str1, -2, -1);
+
+    TEST_ASSERT_EQUAL_UINT32(1, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[3], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("l", sub.str, 1);
 }
 
 void test_strngr_strsub_middle_substring(void)
@@ -1167,13 +1298,12 @@ void test_strngr_strsub_middle_substring(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello World");
     str1.len = 11;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, 2, 3);
-    
-    TEST_ASSERT_EQUAL_UINT32(3, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("llo", buffer2, 3);
+
+    str_t sub = strngr_strsub(str1, 2, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(3, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[2], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("llo", sub.str, 3);
 }
 
 void test_strngr_strsub_negative_start_middle_substring(void)
@@ -1181,12 +1311,2461 @@ void test_strngr_strsub_negative_start_middle_substring(void)
     strngr_new(&str1, buffer1, sizeof(buffer1));
     strcpy(buffer1, "Hello World");
     str1.len = 11;
-    
-    strngr_new(&str2, buffer2, sizeof(buffer2));
-    
-    strngr_strsub(&str2, str1, -9, 3);
-    
-    TEST_ASSERT_EQUAL_UINT32(3, str2.len);
-    TEST_ASSERT_EQUAL_MEMORY("llo", buffer2, 3);
+
+    str_t sub = strngr_strsub(str1, -9, -6);
+
+    TEST_ASSERT_EQUAL_UINT32(3, sub.len);
+    TEST_ASSERT_EQUAL_PTR(&buffer1[2], sub.str);
+    TEST_ASSERT_EQUAL_MEMORY("llo", sub.str, 3);
+}
+
+// ============================================================================
+// Tests for strngr_strstr_compiled
+// ============================================================================
+
+void test_strngr_needle_compile_null_arguments(void)
+{
+    strngr_needle_t needle;
+    str_t pattern = {0, 0, NULL, 0U};
+
+    TEST_ASSERT_NULL(strngr_needle_compile(NULL, STR_T_FROM_CHAR("abc")));
+    TEST_ASSERT_NULL(strngr_needle_compile(&needle, pattern));
+}
+
+void test_strngr_needle_compile_picks_rare_bytes(void)
+{
+    strngr_needle_t needle;
+
+    TEST_ASSERT_EQUAL_PTR(&needle, strngr_needle_compile(&needle, STR_T_FROM_CHAR("the zebra")));
+    TEST_ASSERT_EQUAL('z', needle.pattern.str[needle.rare1]);
+    TEST_ASSERT_NOT_EQUAL(needle.rare1, needle.rare2);
+}
+
+void test_strngr_strstr_compiled_null_needle(void)
+{
+    str_t hay = STR_T_FROM_CHAR("abc");
+    TEST_ASSERT_NULL(strngr_strstr_compiled(hay, NULL).str);
 }
 
+void test_strngr_strstr_compiled_matches_strstr(void)
+{
+    static char hay[1000];
+    strngr_needle_t needle;
+    const char *patterns[] = {"x", "ab", "abcab", "Content-Length", "0123456789012345678901234567890123456789xyz"};
+
+    for (uint32_t i = 0; i < sizeof(hay); i++)
+    {
+        hay[i] = (char)('a' + (i % 3));
+    }
+    memcpy(&hay[600], patterns[3], 14);
+    memcpy(&hay[900], patterns[4], 43);
+    str_t h = {sizeof(hay), sizeof(hay), hay, 0U};
+
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        str_t p = {(uint32_t)strlen(patterns[i]), (uint32_t)strlen(patterns[i]), (char *)patterns[i], 0U};
+        strngr_needle_compile(&needle, p);
+
+        str_t expected = strngr_strstr(h, p);
+        str_t result   = strngr_strstr_compiled(h, &needle);
+        TEST_ASSERT_EQUAL_PTR(expected.str, result.str);
+        TEST_ASSERT_EQUAL_UINT32(expected.len, result.len);
+    }
+}
+
+void test_strngr_strstr_compiled_reused_across_haystacks(void)
+{
+    strngr_needle_t needle;
+    strngr_needle_compile(&needle, STR_T_FROM_CHAR("Host:"));
+
+    char a[] = "GET / HTTP/1.1\r\nHost: x\r\n";
+    char b[] = "POST / HTTP/1.1\r\nAccept: */*\r\n";
+    str_t ha = {25, 25, a, 0U};
+    str_t hb = {30, 30, b, 0U};
+
+    TEST_ASSERT_EQUAL_PTR(&a[16], strngr_strstr_compiled(ha, &needle).str);
+    TEST_ASSERT_NULL(strngr_strstr_compiled(hb, &needle).str);
+}
+
+// ============================================================================
+// Tests for strngr_multi
+// ============================================================================
+
+static uint32_t multi_count_cb(void *ctx, const strngr_match_t *match)
+{
+    (void)match;
+    (*(uint32_t *)ctx)++;
+    return 0U;
+}
+
+static uint32_t multi_stop_cb(void *ctx, const strngr_match_t *match)
+{
+    *(strngr_match_t *)ctx = *match;
+    return 1U;
+}
+
+void test_strngr_multi_compile_null_arguments(void)
+{
+    static uint32_t arena[256];
+    strngr_multi_t multi;
+    str_t patterns[1] = {STR_T_FROM_CHAR("abc")};
+
+    TEST_ASSERT_NULL(strngr_multi_compile(NULL, patterns, 1, arena, sizeof(arena)));
+    TEST_ASSERT_NULL(strngr_multi_compile(&multi, NULL, 1, arena, sizeof(arena)));
+    TEST_ASSERT_NULL(strngr_multi_compile(&multi, patterns, 0, arena, sizeof(arena)));
+}
+
+void test_strngr_multi_mem_required_rejects_empty_pattern(void)
+{
+    str_t patterns[2] = {STR_T_FROM_CHAR("abc"), STR_T_FROM_CHAR("")};
+
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_multi_mem_required(patterns, 2));
+    TEST_ASSERT_NOT_EQUAL(0, strngr_multi_mem_required(patterns, 1));
+}
+
+void test_strngr_multi_arena_too_small(void)
+{
+    static uint32_t arena[4];
+    strngr_multi_t multi;
+    str_t patterns[9] = {STR_T_FROM_CHAR("a"), STR_T_FROM_CHAR("b"), STR_T_FROM_CHAR("c"),
+                         STR_T_FROM_CHAR("d"), STR_T_FROM_CHAR("e"), STR_T_FROM_CHAR("f"),
+                         STR_T_FROM_CHAR("g"), STR_T_FROM_CHAR("h"), STR_T_FROM_CHAR("i")};
+
+    TEST_ASSERT_NULL(strngr_multi_compile(&multi, patterns, 9, arena, sizeof(arena)));
+}
+
+void test_strngr_multi_find_all_overlapping(void)
+{
+    static uint32_t arena[1024];
+    strngr_multi_t multi;
+    strngr_match_t matches[8];
+    str_t patterns[4] = {STR_T_FROM_CHAR("he"), STR_T_FROM_CHAR("she"), STR_T_FROM_CHAR("his"),
+                         STR_T_FROM_CHAR("hers")};
+    str_t hay = STR_T_FROM_CHAR("ushers");
+
+    TEST_ASSERT_TRUE(strngr_multi_mem_required(patterns, 4) <= sizeof(arena));
+    TEST_ASSERT_EQUAL_PTR(&multi, strngr_multi_compile(&multi, patterns, 4, arena, sizeof(arena)));
+
+    // "she" at 1, "he" at 2 and "hers" at 2
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_multi_find_all(&multi, hay, matches, 8));
+
+    uint32_t seen = 0U;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        seen |= 1U << matches[i].pattern;
+        TEST_ASSERT_EQUAL_UINT32((matches[i].pattern == 1U) ? 1U : 2U, matches[i].offset);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0x0B, seen);
+}
+
+void test_strngr_multi_scan_large_set(void)
+{
+    static uint32_t arena[16384];
+    static char words[20][8];
+    str_t patterns[20];
+    strngr_multi_t multi;
+    char hay[] = "k00 k05 xk19x k1 k20";
+
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        words[i][0] = 'k';
+        words[i][1] = (char)('0' + (i / 10));
+        words[i][2] = (char)('0' + (i % 10));
+        patterns[i] = (str_t){3, 3, words[i], 0U};
+    }
+
+    TEST_ASSERT_NOT_NULL(strngr_multi_compile(&multi, patterns, 20, arena, sizeof(arena)));
+    TEST_ASSERT_EQUAL_UINT32(STRNGR_MULTI_DFA, multi.engine);
+
+    uint32_t count = 0U;
+    str_t    h     = {20, 20, hay, 0U};
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_multi_scan(&multi, h, multi_count_cb, &count));
+    TEST_ASSERT_EQUAL_UINT32(3, count);
+}
+
+void test_strngr_multi_scan_callback_stops(void)
+{
+    static uint32_t arena[1024];
+    strngr_multi_t multi;
+    strngr_match_t first = {0U, 0U};
+    str_t patterns[2] = {STR_T_FROM_CHAR("GET"), STR_T_FROM_CHAR("POST")};
+    str_t hay = STR_T_FROM_CHAR("xxPOSTxxGETxxGET");
+
+    TEST_ASSERT_NOT_NULL(strngr_multi_compile(&multi, patterns, 2, arena, sizeof(arena)));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_multi_scan(&multi, hay, multi_stop_cb, &first));
+    TEST_ASSERT_EQUAL_UINT32(1, first.pattern);
+    TEST_ASSERT_EQUAL_UINT32(2, first.offset);
+}
+
+void test_strngr_multi_find_all_respects_cap(void)
+{
+    static uint32_t arena[1024];
+    static char hay[200];
+    strngr_multi_t multi;
+    strngr_match_t matches[4];
+    str_t patterns[1] = {STR_T_FROM_CHAR("ab")};
+
+    for (uint32_t i = 0; i < sizeof(hay); i += 2)
+    {
+        hay[i]     = 'a';
+        hay[i + 1] = 'b';
+    }
+    str_t h = {sizeof(hay), sizeof(hay), hay, 0U};
+
+    TEST_ASSERT_NOT_NULL(strngr_multi_compile(&multi, patterns, 1, arena, sizeof(arena)));
+    TEST_ASSERT_EQUAL_UINT32(4, strngr_multi_find_all(&multi, h, matches, 4));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_multi_find_all(&multi, h, NULL, 4));
+}
+
+/* Every (offset, pattern) occurrence, in the order multi scans promise */
+static uint32_t multi_naive_find_all(const str_t *patterns, uint32_t count, const char *hay, uint32_t len,
+                                     strngr_match_t *out, uint32_t cap)
+{
+    uint32_t n = 0U;
+    for (uint32_t at = 0; at < len; at++)
+    {
+        for (uint32_t p = 0; p < count; p++)
+        {
+            if ((patterns[p].len <= (len - at)) && (memcmp(&hay[at], patterns[p].str, patterns[p].len) == 0))
+            {
+                if (n < cap)
+                {
+                    out[n] = (strngr_match_t){p, at};
+                }
+                n++;
+            }
+        }
+    }
+    return n;
+}
+
+void test_strngr_multi_engines_agree_on_order(void)
+{
+    static uint32_t arena[4096];
+    strngr_multi_t multi;
+    strngr_match_t first[1];
+    strngr_match_t got[32];
+    strngr_match_t want[32];
+    str_t patterns[9] = {STR_T_FROM_CHAR("abcd"), STR_T_FROM_CHAR("bc"),  STR_T_FROM_CHAR("zq1"),
+                         STR_T_FROM_CHAR("zq2"),  STR_T_FROM_CHAR("zq3"), STR_T_FROM_CHAR("zq4"),
+                         STR_T_FROM_CHAR("zq5"),  STR_T_FROM_CHAR("zq6"), STR_T_FROM_CHAR("zq7")};
+    str_t hay = STR_T_FROM_CHAR("abcd");
+    str_t mix = STR_T_FROM_CHAR("xabcdbcabcdabcbcd");
+
+    /* Two patterns take the Teddy engine where SSSE3 is available, nine always take the DFA */
+    for (uint32_t count = 2; count <= 9; count += 7)
+    {
+        TEST_ASSERT_NOT_NULL(strngr_multi_compile(&multi, patterns, count, arena, sizeof(arena)));
+        TEST_ASSERT_EQUAL_UINT32(1, strngr_multi_find_all(&multi, hay, first, 1));
+        TEST_ASSERT_EQUAL_UINT32(0, first[0].pattern);
+        TEST_ASSERT_EQUAL_UINT32(0, first[0].offset);
+
+        const uint32_t n = multi_naive_find_all(patterns, count, mix.str, mix.len, want, 32);
+        TEST_ASSERT_EQUAL_UINT32(n, strngr_multi_find_all(&multi, mix, got, 32));
+        TEST_ASSERT_EQUAL_MEMORY(want, got, n * sizeof(strngr_match_t));
+    }
+}
+
+void test_strngr_multi_nested_matches_in_start_order(void)
+{
+    static uint32_t arena[16384];
+    static char run[16];
+    static strngr_match_t got[512];
+    static strngr_match_t want[512];
+    char hay[] = "aaaaaaaaaaaaaaaaaaaabaaaaaaaaaaaaaaa";
+    str_t patterns[12];
+    strngr_multi_t multi;
+    str_t h = {sizeof(hay) - 1U, sizeof(hay) - 1U, hay, 0U};
+
+    memset(run, 'a', sizeof(run));
+    for (uint32_t i = 0; i < 12; i++)
+    {
+        patterns[i] = (str_t){i + 1U, i + 1U, run, 0U};
+    }
+
+    /* Nine nested patterns fit the pending buffer; twelve nest deeper than it and take the per-position walk */
+    for (uint32_t count = 9; count <= 12; count += 3)
+    {
+        TEST_ASSERT_NOT_NULL(strngr_multi_compile(&multi, patterns, count, arena, sizeof(arena)));
+        TEST_ASSERT_EQUAL_UINT32(STRNGR_MULTI_DFA, multi.engine);
+
+        const uint32_t n = multi_naive_find_all(patterns, count, hay, h.len, want, 512);
+        TEST_ASSERT_EQUAL_UINT32(n, strngr_multi_find_all(&multi, h, got, 512));
+        TEST_ASSERT_EQUAL_MEMORY(want, got, n * sizeof(strngr_match_t));
+    }
+}
+
+// ============================================================================
+// Tests for strngr_new_ex
+// ============================================================================
+
+void test_strngr_new_ex_no_scrub_leaves_buffer(void)
+{
+    char mem[10];
+    str_t str;
+    memset(mem, 'x', sizeof(mem));
+
+    TEST_ASSERT_EQUAL_PTR(mem, strngr_new_ex(&str, mem, sizeof(mem), STRNGR_FLAG_NO_SCRUB));
+    TEST_ASSERT_EQUAL_UINT32(0, str.len);
+    TEST_ASSERT_EQUAL_UINT32(10, str.max_len);
+    TEST_ASSERT_EQUAL_UINT32(STRNGR_FLAG_NO_SCRUB, str.term);
+    TEST_ASSERT_EQUAL('x', mem[9]);
+}
+
+void test_strngr_new_ex_default_flags_scrub(void)
+{
+    char mem[10];
+    str_t str;
+    memset(mem, 'x', sizeof(mem));
+
+    TEST_ASSERT_NOT_NULL(strngr_new_ex(&str, mem, sizeof(mem), 0U));
+    TEST_ASSERT_EQUAL(0, mem[9]);
+}
+
+void test_strngr_new_s_ex_no_scrub_copies_only(void)
+{
+    char mem[10];
+    memset(mem, 'x', sizeof(mem));
+
+    str_t str = strngr_new_s_ex(mem, sizeof(mem), "abc", STRNGR_FLAG_NO_SCRUB);
+    TEST_ASSERT_EQUAL_UINT32(3, str.len);
+    TEST_ASSERT_EQUAL_MEMORY("abcx", mem, 4);
+}
+
+void test_strngr_new_s_ex_scrubs_tail(void)
+{
+    char mem[10];
+    memset(mem, 'x', sizeof(mem));
+
+    str_t str = strngr_new_s_ex(mem, sizeof(mem), "abc", 0U);
+    TEST_ASSERT_EQUAL_UINT32(3, str.len);
+    TEST_ASSERT_EQUAL_MEMORY("abc\0\0\0\0\0\0\0", mem, 10);
+}
+
+void test_strngr_reset_to_empty_no_scrub(void)
+{
+    char mem[10];
+    str_t str;
+    strngr_new_ex(&str, mem, sizeof(mem), STRNGR_FLAG_NO_SCRUB);
+    memcpy(mem, "Hello", 5);
+    str.len = 5;
+
+    strngr_reset_to_empty(&str);
+
+    TEST_ASSERT_EQUAL_UINT32(0, str.len);
+    TEST_ASSERT_EQUAL_UINT32(10, str.max_len);
+    TEST_ASSERT_EQUAL_MEMORY("Hello", mem, 5);
+}
+
+// ============================================================================
+// Tests for strngr_cstr
+// ============================================================================
+
+void test_strngr_cstr_null_string(void)
+{
+    str_t str = {0, 0, NULL, STRNGR_FLAG_TERMINATED};
+    TEST_ASSERT_NULL(strngr_cstr(str));
+}
+
+void test_strngr_cstr_terminated_new_s(void)
+{
+    char mem[6];
+    memset(mem, 'x', sizeof(mem));
+
+    str_t str = strngr_new_s_ex(mem, sizeof(mem), "Hello World", STRNGR_FLAG_NO_SCRUB | STRNGR_FLAG_TERMINATED);
+
+    // One byte is reserved for the terminator
+    TEST_ASSERT_EQUAL_UINT32(5, str.len);
+    TEST_ASSERT_EQUAL_PTR(mem, strngr_cstr(str));
+    TEST_ASSERT_EQUAL_STRING("Hello", strngr_cstr(str));
+}
+
+void test_strngr_cstr_terminated_strncat_and_strcat(void)
+{
+    char mem[8];
+    str_t str;
+    memset(mem, 'x', sizeof(mem));
+    strngr_new_ex(&str, mem, sizeof(mem), STRNGR_FLAG_NO_SCRUB | STRNGR_FLAG_TERMINATED);
+    TEST_ASSERT_EQUAL_STRING("", strngr_cstr(str));
+
+    strngr_strncat(&str, STR_T_FROM_CHAR("abcdef"), 3);
+    TEST_ASSERT_EQUAL_STRING("abc", strngr_cstr(str));
+
+    strngr_strcat(&str, STR_T_FROM_CHAR("defg"));
+    TEST_ASSERT_EQUAL_STRING("abcdefg", strngr_cstr(str));
+
+    // No room left once the terminator is accounted for
+    strngr_strcat(&str, STR_T_FROM_CHAR("h"));
+    TEST_ASSERT_EQUAL_UINT32(7, str.len);
+    TEST_ASSERT_EQUAL_STRING("abcdefg", strngr_cstr(str));
+}
+
+void test_strngr_cstr_terminated_strcpy_and_strncpy(void)
+{
+    char mem[5];
+    str_t str;
+    strngr_new_ex(&str, mem, sizeof(mem), STRNGR_FLAG_NO_SCRUB | STRNGR_FLAG_TERMINATED);
+
+    strngr_strcpy(STR_T_FROM_CHAR("Hello"), &str);
+    TEST_ASSERT_EQUAL_UINT32(4, str.len);
+    TEST_ASSERT_EQUAL_STRING("Hell", strngr_cstr(str));
+
+    strngr_strncpy(STR_T_FROM_CHAR("Hi"), &str, 4);
+    TEST_ASSERT_EQUAL_UINT32(2, str.len);
+    TEST_ASSERT_EQUAL_STRING("Hi", strngr_cstr(str));
+}
+
+void test_strngr_cstr_reset_terminated(void)
+{
+    char mem[8];
+    str_t str = strngr_new_s_ex(mem, sizeof(mem), "abc", STRNGR_FLAG_NO_SCRUB | STRNGR_FLAG_TERMINATED);
+
+    strngr_reset_to_empty(&str);
+    TEST_ASSERT_EQUAL_STRING("", strngr_cstr(str));
+}
+
+void test_strngr_cstr_unterminated_string(void)
+{
+    char mem[4] = {'a', 'b', 'c', 'd'};
+    str_t full = {4, 4, mem, 0U};
+    str_t part = {4, 2, mem, 0U};
+
+    TEST_ASSERT_NULL(strngr_cstr(full));
+    TEST_ASSERT_NULL(strngr_cstr(part));
+
+    // A NUL after a plain string is not kept there, so it does not qualify either
+    mem[2] = '\0';
+    TEST_ASSERT_NULL(strngr_cstr(part));
+}
+
+void test_strngr_cstr_substring_drops_terminated(void)
+{
+    char mem[16];
+    str_t str = strngr_new_s_ex(mem, sizeof(mem), "path/to/file", STRNGR_FLAG_TERMINATED);
+
+    TEST_ASSERT_EQUAL_STRING("file", strngr_cstr(strngr_strsub(str, 8, 12)));
+    TEST_ASSERT_NULL(strngr_cstr(strngr_strsub(str, 0, 4)));
+    TEST_ASSERT_EQUAL_STRING("to/file", strngr_cstr(strngr_strstr(str, STR_T_FROM_CHAR("to"))));
+}
+
+// ============================================================================
+// Tests for STR_T_LITERAL
+// ============================================================================
+
+static const str_t literal_key = STR_T_LITERAL_INIT("Content-Type");
+
+void test_str_t_literal_static_initializer(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(12, literal_key.len);
+    TEST_ASSERT_EQUAL_UINT32(13, literal_key.max_len);
+    TEST_ASSERT_EQUAL_UINT32(STRNGR_FLAG_TERMINATED, literal_key.term);
+    TEST_ASSERT_EQUAL_STRING("Content-Type", strngr_cstr(literal_key));
+}
+
+void test_str_t_literal_matches_from_char(void)
+{
+    str_t lit = STR_T_LITERAL("Hello");
+    str_t run = STR_T_FROM_CHAR("Hello");
+
+    TEST_ASSERT_EQUAL_UINT32(run.len, lit.len);
+    TEST_ASSERT_EQUAL_INT32(0, strngr_strncmp(lit, run, 5));
+}
+
+void test_str_t_literal_empty(void)
+{
+    str_t lit = STR_T_LITERAL("");
+
+    TEST_ASSERT_EQUAL_UINT32(0, lit.len);
+    TEST_ASSERT_EQUAL_UINT32(1, lit.max_len);
+    TEST_ASSERT_EQUAL_STRING("", strngr_cstr(lit));
+}
+
+// ============================================================================
+// Tests for strngr_view
+// ============================================================================
+
+void test_strngr_view_size(void)
+{
+    TEST_ASSERT_TRUE(sizeof(str_view_t) <= (2U * sizeof(void *)));
+}
+
+void test_strngr_view_from_str_t(void)
+{
+    char mem[16];
+    str_t str = strngr_new_s(mem, sizeof(mem), "Hello");
+
+    str_view_t view = strngr_view(&str);
+    TEST_ASSERT_EQUAL_PTR(mem, view.str);
+    TEST_ASSERT_EQUAL_UINT32(5, view.len);
+    TEST_ASSERT_EQUAL_UINT32(5, strngr_view_strlen(view));
+
+    TEST_ASSERT_NULL(strngr_view(NULL).str);
+}
+
+void test_strngr_view_null_view(void)
+{
+    str_view_t null_view = {NULL, 0U};
+    str_view_t view      = STR_VIEW_LITERAL("abc");
+
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_view_strlen(null_view));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_view_strcspn(null_view, 'a'));
+    TEST_ASSERT_NULL(strngr_view_strchr(null_view, 'a'));
+    TEST_ASSERT_EQUAL_INT32(0, strngr_view_strncmp(null_view, view, 3));
+    TEST_ASSERT_NULL(strngr_view_strstr(null_view, view).str);
+    TEST_ASSERT_NULL(strngr_view_strsub(null_view, 0, 1).str);
+}
+
+void test_strngr_view_strcspn_and_strchr(void)
+{
+    str_view_t view = STR_VIEW_LITERAL("key=value");
+
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_view_strcspn(view, '='));
+    TEST_ASSERT_EQUAL_UINT32(9, strngr_view_strcspn(view, ';'));
+    TEST_ASSERT_EQUAL_PTR(&view.str[3], strngr_view_strchr(view, '='));
+    TEST_ASSERT_NULL(strngr_view_strchr(view, ';'));
+}
+
+void test_strngr_view_strncmp_matches_str_t(void)
+{
+    str_view_t a = STR_VIEW_LITERAL("Hello");
+    str_view_t b = STR_VIEW_LITERAL("Help");
+
+    TEST_ASSERT_EQUAL_INT32(0, strngr_view_strncmp(a, b, 3));
+    TEST_ASSERT_EQUAL_INT32(strngr_strncmp(STR_T_LITERAL("Hello"), STR_T_LITERAL("Help"), 4),
+                            strngr_view_strncmp(a, b, 4));
+}
+
+void test_strngr_view_strstr_and_compiled(void)
+{
+    str_view_t      hay = STR_VIEW_LITERAL("GET /index.html HTTP/1.1");
+    strngr_needle_t needle;
+
+    str_view_t result = strngr_view_strstr(hay, STR_VIEW_LITERAL("HTTP"));
+    TEST_ASSERT_EQUAL_PTR(&hay.str[16], result.str);
+    TEST_ASSERT_EQUAL_UINT32(8, result.len);
+
+    strngr_needle_compile(&needle, STR_T_LITERAL("index"));
+    result = strngr_view_strstr_compiled(hay, &needle);
+    TEST_ASSERT_EQUAL_PTR(&hay.str[5], result.str);
+    TEST_ASSERT_EQUAL_UINT32(19, result.len);
+
+    TEST_ASSERT_NULL(strngr_view_strstr(hay, STR_VIEW_LITERAL("POST")).str);
+}
+
+void test_strngr_view_strsub(void)
+{
+    str_view_t view = STR_VIEW_LITERAL("Hello World");
+
+    str_view_t result = strngr_view_strsub(view, -5, 11);
+    TEST_ASSERT_EQUAL_PTR(&view.str[6], result.str);
+    TEST_ASSERT_EQUAL_UINT32(5, result.len);
+
+    TEST_ASSERT_NULL(strngr_view_strsub(view, 4, 2).str);
+}
+
+// ============================================================================
+// Tests for strngr_equal
+// ============================================================================
+
+void test_strngr_equal_null_strings(void)
+{
+    str_t null_str = {0, 0, NULL, 0U};
+
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_equal(null_str, null_str));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_equal(null_str, STR_T_LITERAL("")));
+}
+
+void test_strngr_equal_same_content(void)
+{
+    char mem[32];
+    str_t str = strngr_new_s(mem, sizeof(mem), "Content-Length");
+
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_equal(str, STR_T_LITERAL("Content-Length")));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_equal(str, str));
+}
+
+void test_strngr_equal_different_length(void)
+{
+    // A prefix is not equal, unlike strngr_strncmp with n bounded by the shorter string
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_equal(STR_T_LITERAL("Host"), STR_T_LITERAL("Hostname")));
+    TEST_ASSERT_EQUAL_INT32(0, strngr_strncmp(STR_T_LITERAL("Host"), STR_T_LITERAL("Hostname"), 8));
+}
+
+void test_strngr_equal_different_content(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_equal(STR_T_LITERAL("Accept"), STR_T_LITERAL("Accent")));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_view_equal(STR_VIEW_LITERAL("Accept"), STR_VIEW_LITERAL("Accent")));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_view_equal(STR_VIEW_LITERAL("Accept"), STR_VIEW_LITERAL("Accept")));
+}
+
+// ============================================================================
+// Tests for strngr_new_s_trunc
+// ============================================================================
+
+void test_strngr_new_s_trunc_reports_truncation(void)
+{
+    char mem[5];
+    uint32_t truncated = 0U;
+
+    str_t str = strngr_new_s_trunc(mem, sizeof(mem), "Hello World", 0U, &truncated);
+    TEST_ASSERT_EQUAL_UINT32(5, str.len);
+    TEST_ASSERT_EQUAL_UINT32(1, truncated);
+    TEST_ASSERT_EQUAL_MEMORY("Hello", mem, 5);
+}
+
+void test_strngr_new_s_trunc_exact_fit(void)
+{
+    char mem[5];
+    uint32_t truncated = 1U;
+
+    str_t str = strngr_new_s_trunc(mem, sizeof(mem), "Hello", 0U, &truncated);
+    TEST_ASSERT_EQUAL_UINT32(5, str.len);
+    TEST_ASSERT_EQUAL_UINT32(0, truncated);
+}
+
+void test_strngr_new_s_trunc_terminated_reserves_byte(void)
+{
+    char mem[5];
+    uint32_t truncated = 0U;
+
+    str_t str = strngr_new_s_trunc(mem, sizeof(mem), "Hello", STRNGR_FLAG_TERMINATED, &truncated);
+    TEST_ASSERT_EQUAL_UINT32(4, str.len);
+    TEST_ASSERT_EQUAL_UINT32(1, truncated);
+    TEST_ASSERT_EQUAL_STRING("Hell", strngr_cstr(str));
+}
+
+void test_strngr_new_s_trunc_reads_only_capacity(void)
+{
+    // The source has no terminator within reach; only mem_len + 1 bytes may be read
+    char source[9] = {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i'};
+    char mem[8];
+    uint32_t truncated = 0U;
+
+    str_t str = strngr_new_s_trunc(mem, sizeof(mem), source, 0U, &truncated);
+    TEST_ASSERT_EQUAL_UINT32(8, str.len);
+    TEST_ASSERT_EQUAL_UINT32(1, truncated);
+}
+
+void test_strngr_new_s_trunc_null_truncated_pointer(void)
+{
+    char mem[3];
+    str_t str = strngr_new_s_trunc(mem, sizeof(mem), "abcdef", 0U, NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, str.len);
+}
+
+void test_strngr_new_s_bulk_packs_strings(void)
+{
+    const char *strings[3] = {"GET", "/index.html", "HTTP/1.1"};
+    char mem[32];
+    str_t out[3];
+
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_new_s_bulk(out, strings, 3, mem, sizeof(mem), STRNGR_FLAG_TERMINATED));
+
+    TEST_ASSERT_EQUAL_PTR(&mem[0], out[0].str);
+    TEST_ASSERT_EQUAL_PTR(&mem[4], out[1].str);
+    TEST_ASSERT_EQUAL_PTR(&mem[16], out[2].str);
+    TEST_ASSERT_EQUAL_UINT32(11, out[1].len);
+    TEST_ASSERT_EQUAL_UINT32(12, out[1].max_len);
+    TEST_ASSERT_EQUAL_STRING("/index.html", strngr_cstr(out[1]));
+    TEST_ASSERT_EQUAL_STRING("HTTP/1.1", strngr_cstr(out[2]));
+}
+
+void test_strngr_new_s_bulk_stops_when_full(void)
+{
+    const char *strings[3] = {"alpha", "beta", "gamma"};
+    char mem[12];
+    str_t out[3];
+
+    // "alpha" and "beta" fit in 9 bytes, "gamma" does not fit in the remaining 3
+    TEST_ASSERT_EQUAL_UINT32(2, strngr_new_s_bulk(out, strings, 3, mem, sizeof(mem), 0U));
+    TEST_ASSERT_EQUAL_UINT32(5, out[0].max_len);
+    TEST_ASSERT_EQUAL_MEMORY("alphabeta", mem, 9);
+}
+
+void test_strngr_new_s_bulk_empty_needs_no_room(void)
+{
+    const char *strings[4] = {"abcd", "", "", "e"};
+    char mem[4];
+    char tmem[5];
+    str_t out[4];
+
+    // The buffer is full after "abcd", but empty strings still fit; "e" does not
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_new_s_bulk(out, strings, 4, mem, sizeof(mem), 0U));
+    TEST_ASSERT_EQUAL_UINT32(0, out[1].len);
+    TEST_ASSERT_EQUAL_UINT32(0, out[2].max_len);
+    TEST_ASSERT_NOT_NULL(out[2].str);
+
+    // A terminated empty string needs its NUL byte
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_new_s_bulk(out, strings, 4, tmem, sizeof(tmem), STRNGR_FLAG_TERMINATED));
+}
+
+void test_strngr_new_s_bulk_null_arguments(void)
+{
+    const char *strings[2] = {"a", NULL};
+    char mem[8];
+    str_t out[2];
+
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_new_s_bulk(NULL, strings, 2, mem, sizeof(mem), 0U));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_new_s_bulk(out, NULL, 2, mem, sizeof(mem), 0U));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_new_s_bulk(out, strings, 2, mem, sizeof(mem), 0U));
+}
+
+// ============================================================================
+// Tests for strngr_arena
+// ============================================================================
+
+void test_strngr_arena_init_null_arguments(void)
+{
+    static char block[16];
+    strngr_arena_t arena;
+
+    TEST_ASSERT_NULL(strngr_arena_init(NULL, block, sizeof(block), 0U));
+    TEST_ASSERT_NULL(strngr_arena_init(&arena, NULL, sizeof(block), 0U));
+    TEST_ASSERT_EQUAL_PTR(&arena, strngr_arena_init(&arena, block, sizeof(block), 0U));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_arena_mark(&arena));
+}
+
+void test_strngr_arena_alloc_alignment(void)
+{
+    static char block[64];
+    strngr_arena_t arena;
+    strngr_arena_init(&arena, &block[1], 63, 0U);
+
+    char *a = (char *)strngr_arena_alloc(&arena, 3, 1U);
+    void *b = strngr_arena_alloc(&arena, 8, 8U);
+
+    TEST_ASSERT_EQUAL_PTR(&block[1], a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)b & 7U));
+    TEST_ASSERT_NULL(strngr_arena_alloc(&arena, 1, 3U));
+}
+
+void test_strngr_arena_alloc_exhausted(void)
+{
+    static char block[16];
+    strngr_arena_t arena;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+
+    TEST_ASSERT_NOT_NULL(strngr_arena_alloc(&arena, 16, 1U));
+    TEST_ASSERT_NULL(strngr_arena_alloc(&arena, 1, 1U));
+    TEST_ASSERT_EQUAL_UINT32(16, strngr_arena_mark(&arena));
+}
+
+void test_strngr_arena_mark_rewind_reset(void)
+{
+    static char block[32];
+    strngr_arena_t arena;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+
+    str_t keep = strngr_arena_new_s(&arena, "keep");
+    uint32_t mark = strngr_arena_mark(&arena);
+    str_t scratch = strngr_arena_new_s(&arena, "scratch");
+    TEST_ASSERT_EQUAL_PTR(&block[4], scratch.str);
+
+    strngr_arena_rewind(&arena, mark);
+    TEST_ASSERT_EQUAL_UINT32(4, strngr_arena_mark(&arena));
+    TEST_ASSERT_EQUAL_MEMORY("keep", keep.str, 4);
+
+    // Rewinding forward is ignored
+    strngr_arena_rewind(&arena, 30);
+    TEST_ASSERT_EQUAL_UINT32(4, strngr_arena_mark(&arena));
+
+    strngr_arena_reset(&arena);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_arena_mark(&arena));
+}
+
+void test_strngr_arena_new_s_packs_terminated(void)
+{
+    static char block[16];
+    strngr_arena_t arena;
+    strngr_arena_init(&arena, block, sizeof(block), STRNGR_FLAG_TERMINATED);
+
+    str_t a = strngr_arena_new_s(&arena, "abc");
+    str_t b = strngr_arena_new_s(&arena, "defg");
+
+    TEST_ASSERT_EQUAL_UINT32(3, a.len);
+    TEST_ASSERT_EQUAL_UINT32(4, a.max_len);
+    TEST_ASSERT_EQUAL_PTR(&block[4], b.str);
+    TEST_ASSERT_EQUAL_STRING("abc", strngr_cstr(a));
+    TEST_ASSERT_EQUAL_STRING("defg", strngr_cstr(b));
+
+    // Does not fit in the 7 bytes left, and leaves the arena untouched
+    TEST_ASSERT_NULL(strngr_arena_new_s(&arena, "too long!").str);
+    TEST_ASSERT_EQUAL_UINT32(9, strngr_arena_mark(&arena));
+}
+
+void test_strngr_arena_new_capacity(void)
+{
+    static char block[16];
+    strngr_arena_t arena;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+
+    str_t str = strngr_arena_new(&arena, 10);
+    TEST_ASSERT_EQUAL_UINT32(10, str.max_len);
+    TEST_ASSERT_EQUAL_UINT32(0, str.len);
+    TEST_ASSERT_NULL(strngr_arena_new(&arena, 10).str);
+}
+
+void test_strngr_arena_strcat_grows_in_place(void)
+{
+    static char block[32];
+    strngr_arena_t arena;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+
+    str_t str = strngr_arena_new_s(&arena, "Hello");
+    strngr_arena_strcat(&arena, &str, STR_T_LITERAL(", World"));
+
+    TEST_ASSERT_EQUAL_PTR(block, str.str);
+    TEST_ASSERT_EQUAL_UINT32(12, str.len);
+    TEST_ASSERT_EQUAL_MEMORY("Hello, World", str.str, 12);
+    TEST_ASSERT_EQUAL_UINT32(12, strngr_arena_mark(&arena));
+}
+
+void test_strngr_arena_strcat_moves_older_string(void)
+{
+    static char block[32];
+    strngr_arena_t arena;
+    strngr_arena_init(&arena, block, sizeof(block), STRNGR_FLAG_TERMINATED);
+
+    str_t a = strngr_arena_new_s(&arena, "ab");
+    str_t b = strngr_arena_new_s(&arena, "cd");
+    strngr_arena_strcat(&arena, &a, b);
+
+    TEST_ASSERT_EQUAL_PTR(&block[6], a.str);
+    TEST_ASSERT_EQUAL_STRING("abcd", strngr_cstr(a));
+    TEST_ASSERT_EQUAL_STRING("cd", strngr_cstr(b));
+}
+
+void test_strngr_arena_strsub_copies(void)
+{
+    static char block[16];
+    strngr_arena_t arena;
+    strngr_arena_init(&arena, block, sizeof(block), STRNGR_FLAG_TERMINATED);
+
+    str_t sub = strngr_arena_strsub(&arena, STR_T_LITERAL("path/to/file.txt"), -8, -4);
+    TEST_ASSERT_EQUAL_PTR(block, sub.str);
+    TEST_ASSERT_EQUAL_UINT32(4, sub.len);
+    TEST_ASSERT_EQUAL_STRING("file", strngr_cstr(sub));
+
+    TEST_ASSERT_NULL(strngr_arena_strsub(&arena, STR_T_LITERAL("abc"), 2, 1).str);
+}
+
+// ============================================================================
+// Tests for strngr_hash
+// ============================================================================
+
+void test_strngr_hash_depends_on_content_only(void)
+{
+    char a[16] = "hello world";
+    char b[32] = "xxhello world";
+    str_t sa = {sizeof(a), 11, a, 0U};
+    str_t sb = {sizeof(b), 11, &b[2], 0U};
+
+    TEST_ASSERT_TRUE(strngr_hash(sa) == strngr_hash(sb));
+    TEST_ASSERT_TRUE(strngr_hash(sa) == strngr_view_hash(strngr_view(&sb), 0U));
+    TEST_ASSERT_TRUE(strngr_hash(sa) != strngr_hash(STR_T_LITERAL("hello worle")));
+}
+
+void test_strngr_hash_every_length(void)
+{
+    static char buf[200];
+    static uint64_t seen[200];
+
+    for (uint32_t i = 0; i < sizeof(buf); i++)
+    {
+        buf[i] = (char)('a' + (i % 26U));
+    }
+
+    // Each prefix hashes differently, across the short, medium and 48-byte block paths
+    for (uint32_t len = 0; len < 200; len++)
+    {
+        str_t s = {len, len, buf, 0U};
+        seen[len] = strngr_hash(s);
+        for (uint32_t j = 0; j < len; j++)
+        {
+            TEST_ASSERT_TRUE(seen[j] != seen[len]);
+        }
+    }
+}
+
+void test_strngr_hash_seeded(void)
+{
+    str_t s = STR_T_LITERAL("key");
+
+    TEST_ASSERT_TRUE(strngr_hash_seeded(s, 0U) == strngr_hash(s));
+    TEST_ASSERT_TRUE(strngr_hash_seeded(s, 1U) != strngr_hash_seeded(s, 2U));
+    TEST_ASSERT_TRUE(strngr_hash_seeded(s, 1U) == strngr_hash_seeded(s, 1U));
+}
+
+void test_strngr_hash_null_is_empty(void)
+{
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    TEST_ASSERT_TRUE(strngr_hash(null_str) == strngr_hash(STR_T_LITERAL("")));
+}
+
+// ============================================================================
+// Tests for strngr_map
+// ============================================================================
+
+void test_strngr_map_init(void)
+{
+    static uint64_t block[512];
+    strngr_arena_t arena;
+    strngr_map_t map;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+
+    TEST_ASSERT_NULL(strngr_map_init(NULL, &arena, 16, 0U));
+    TEST_ASSERT_NULL(strngr_map_init(&map, NULL, 16, 0U));
+    TEST_ASSERT_NULL(strngr_map_init(&map, &arena, 1024, 0U));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_arena_mark(&arena));
+
+    // Rounded up to a whole number of groups
+    TEST_ASSERT_EQUAL_PTR(&map, strngr_map_init(&map, &arena, 20, 0U));
+    TEST_ASSERT_EQUAL_UINT32(32, map.capacity);
+    TEST_ASSERT_EQUAL_UINT32(0, map.count);
+    TEST_ASSERT_TRUE(strngr_arena_mark(&arena) <= strngr_map_mem_required(20));
+}
+
+void test_strngr_map_put_find(void)
+{
+    static uint64_t block[512];
+    strngr_arena_t arena;
+    strngr_map_t map;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    strngr_map_init(&map, &arena, 16, 42U);
+
+    TEST_ASSERT_NOT_NULL(strngr_map_put(&map, STR_T_LITERAL("apple"), 1U));
+    TEST_ASSERT_NOT_NULL(strngr_map_put(&map, STR_T_LITERAL("banana"), 2U));
+    TEST_ASSERT_NOT_NULL(strngr_map_put(&map, STR_T_LITERAL(""), 3U));
+
+    TEST_ASSERT_EQUAL_UINT64(1U, *strngr_map_find(&map, STR_T_LITERAL("apple")));
+    TEST_ASSERT_EQUAL_UINT64(2U, *strngr_map_find(&map, STR_T_LITERAL("banana")));
+    TEST_ASSERT_EQUAL_UINT64(3U, *strngr_map_find(&map, STR_T_LITERAL("")));
+    TEST_ASSERT_EQUAL_UINT64(1U, *strngr_view_map_find(&map, STR_VIEW_LITERAL("apple")));
+    TEST_ASSERT_NULL(strngr_map_find(&map, STR_T_LITERAL("cherry")));
+    TEST_ASSERT_NULL(strngr_map_find(&map, STR_T_LITERAL("appl")));
+
+    // Putting an existing key overwrites its value
+    *strngr_map_put(&map, STR_T_LITERAL("apple"), 10U) += 1U;
+    TEST_ASSERT_EQUAL_UINT64(11U, *strngr_map_find(&map, STR_T_LITERAL("apple")));
+    TEST_ASSERT_EQUAL_UINT32(3, map.count);
+}
+
+void test_strngr_map_copies_keys(void)
+{
+    static uint64_t block[512];
+    strngr_arena_t arena;
+    strngr_map_t map;
+    char key[] = "mutable";
+    str_t k = {sizeof(key), 7, key, 0U};
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    strngr_map_init(&map, &arena, 16, 0U);
+
+    strngr_map_put(&map, k, 7U);
+    key[0] = 'M';
+
+    TEST_ASSERT_NULL(strngr_map_find(&map, k));
+    TEST_ASSERT_EQUAL_UINT64(7U, *strngr_map_find(&map, STR_T_LITERAL("mutable")));
+}
+
+void test_strngr_map_remove(void)
+{
+    static uint64_t block[512];
+    strngr_arena_t arena;
+    strngr_map_t map;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    strngr_map_init(&map, &arena, 16, 0U);
+
+    strngr_map_put(&map, STR_T_LITERAL("one"), 1U);
+    strngr_map_put(&map, STR_T_LITERAL("two"), 2U);
+
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_map_remove(&map, STR_T_LITERAL("one")));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_map_remove(&map, STR_T_LITERAL("one")));
+    TEST_ASSERT_NULL(strngr_map_find(&map, STR_T_LITERAL("one")));
+    TEST_ASSERT_EQUAL_UINT64(2U, *strngr_map_find(&map, STR_T_LITERAL("two")));
+    TEST_ASSERT_EQUAL_UINT32(1, map.count);
+
+    strngr_map_put(&map, STR_T_LITERAL("one"), 3U);
+    TEST_ASSERT_EQUAL_UINT64(3U, *strngr_map_find(&map, STR_T_LITERAL("one")));
+}
+
+void test_strngr_map_fill_limit(void)
+{
+    static uint64_t block[1024];
+    strngr_arena_t arena;
+    strngr_map_t map;
+    char key[8];
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    strngr_map_init(&map, &arena, 16, 0U);
+
+    // 16 slots take at most 14 keys
+    for (uint32_t i = 0; i < 14; i++)
+    {
+        key[0] = (char)('a' + i);
+        str_t k = {1, 1, key, 0U};
+        TEST_ASSERT_NOT_NULL(strngr_map_put(&map, k, i));
+    }
+    str_t extra = STR_T_LITERAL("z");
+    TEST_ASSERT_NULL(strngr_map_put(&map, extra, 0U));
+
+    // Every key is still reachable, and existing keys can still be updated
+    for (uint32_t i = 0; i < 14; i++)
+    {
+        key[0] = (char)('a' + i);
+        str_t k = {1, 1, key, 0U};
+        TEST_ASSERT_EQUAL_UINT64(i, *strngr_map_find(&map, k));
+    }
+    TEST_ASSERT_NOT_NULL(strngr_map_put(&map, STR_T_LITERAL("a"), 100U));
+}
+
+void test_strngr_map_many_keys(void)
+{
+    static uint64_t block[8192];
+    strngr_arena_t arena;
+    strngr_map_t map;
+    char key[16];
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    TEST_ASSERT_NOT_NULL(strngr_map_init(&map, &arena, 1024, 7U));
+
+    for (uint32_t i = 0; i < 800; i++)
+    {
+        int n = snprintf(key, sizeof(key), "key-%u", (unsigned)i);
+        str_t k = {sizeof(key), (uint32_t)n, key, 0U};
+        TEST_ASSERT_NOT_NULL(strngr_map_put(&map, k, i));
+    }
+
+    // Drop every third key, then look everything up again
+    for (uint32_t i = 0; i < 800; i += 3)
+    {
+        int n = snprintf(key, sizeof(key), "key-%u", (unsigned)i);
+        str_t k = {sizeof(key), (uint32_t)n, key, 0U};
+        TEST_ASSERT_EQUAL_UINT32(1, strngr_map_remove(&map, k));
+    }
+    for (uint32_t i = 0; i < 800; i++)
+    {
+        int n = snprintf(key, sizeof(key), "key-%u", (unsigned)i);
+        str_t k = {sizeof(key), (uint32_t)n, key, 0U};
+        uint64_t *value = strngr_map_find(&map, k);
+        if ((i % 3U) == 0U)
+        {
+            TEST_ASSERT_NULL(value);
+        }
+        else
+        {
+            TEST_ASSERT_NOT_NULL(value);
+            TEST_ASSERT_EQUAL_UINT64(i, *value);
+        }
+    }
+}
+
+void test_strngr_map_arena_exhausted(void)
+{
+    static uint64_t block[128];
+    strngr_arena_t arena;
+    strngr_map_t map;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    strngr_map_init(&map, &arena, 16, 0U);
+
+    // Leave room for exactly five key bytes
+    strngr_arena_alloc(&arena, arena.size - arena.used - 5U, 1U);
+
+    TEST_ASSERT_NOT_NULL(strngr_map_put(&map, STR_T_LITERAL("abcde"), 1U));
+    TEST_ASSERT_NULL(strngr_map_put(&map, STR_T_LITERAL("f"), 2U));
+    TEST_ASSERT_EQUAL_UINT32(1, map.count);
+    TEST_ASSERT_EQUAL_UINT64(1U, *strngr_map_find(&map, STR_T_LITERAL("abcde")));
+}
+
+// ============================================================================
+// Tests for strngr_intern
+// ============================================================================
+
+void test_strngr_intern_init(void)
+{
+    static uint64_t block[64];
+    strngr_arena_t arena;
+    strngr_intern_t pool;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+
+    TEST_ASSERT_NULL(strngr_intern_init(NULL, &arena, 16, 0U));
+    TEST_ASSERT_NULL(strngr_intern_init(&pool, NULL, 16, 0U));
+    TEST_ASSERT_NULL(strngr_intern_init(&pool, &arena, 1024, 0U));
+
+    TEST_ASSERT_EQUAL_PTR(&pool, strngr_intern_init(&pool, &arena, 10, 0U));
+    TEST_ASSERT_EQUAL_UINT32(16, pool.capacity);
+    TEST_ASSERT_TRUE(strngr_arena_mark(&arena) <= strngr_intern_mem_required(10));
+}
+
+void test_strngr_intern_deduplicates(void)
+{
+    static uint64_t block[256];
+    strngr_arena_t arena;
+    strngr_intern_t pool;
+    char buf[16] = "Content-Type";
+    str_t a = {sizeof(buf), 12, buf, 0U};
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    strngr_intern_init(&pool, &arena, 16, 0U);
+
+    str_view_t first = strngr_intern(&pool, a);
+    str_view_t second = strngr_intern(&pool, STR_T_LITERAL("Content-Type"));
+    str_view_t other = strngr_intern(&pool, STR_T_LITERAL("Content-Length"));
+
+    // Equal strings share one copy, which outlives the caller's buffer and is NUL-terminated
+    TEST_ASSERT_EQUAL_PTR(first.str, second.str);
+    TEST_ASSERT_TRUE(first.str != buf);
+    TEST_ASSERT_TRUE(first.str != other.str);
+    TEST_ASSERT_EQUAL_UINT32(12, first.len);
+    TEST_ASSERT_EQUAL_STRING("Content-Type", first.str);
+    TEST_ASSERT_EQUAL_UINT32(2, pool.count);
+
+    uint32_t used = strngr_arena_mark(&arena);
+    TEST_ASSERT_EQUAL_PTR(first.str, strngr_view_intern(&pool, STR_VIEW_LITERAL("Content-Type")).str);
+    TEST_ASSERT_EQUAL_UINT32(used, strngr_arena_mark(&arena));
+}
+
+void test_strngr_intern_find(void)
+{
+    static uint64_t block[256];
+    strngr_arena_t arena;
+    strngr_intern_t pool;
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    strngr_intern_init(&pool, &arena, 16, 0U);
+
+    TEST_ASSERT_NULL(strngr_intern_find(&pool, STR_T_LITERAL("tag")).str);
+
+    str_view_t tag = strngr_intern(&pool, STR_T_LITERAL("tag"));
+    TEST_ASSERT_EQUAL_PTR(tag.str, strngr_intern_find(&pool, STR_T_LITERAL("tag")).str);
+    TEST_ASSERT_EQUAL_PTR(tag.str, strngr_view_intern_find(&pool, STR_VIEW_LITERAL("tag")).str);
+    TEST_ASSERT_NULL(strngr_intern_find(&pool, STR_T_LITERAL("ta")).str);
+    TEST_ASSERT_EQUAL_UINT32(1, pool.count);
+}
+
+void test_strngr_intern_empty_string(void)
+{
+    static uint64_t block[256];
+    strngr_arena_t arena;
+    strngr_intern_t pool;
+    str_t null_str = {0U, 0U, NULL, 0U};
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    strngr_intern_init(&pool, &arena, 16, 0U);
+
+    str_view_t empty = strngr_intern(&pool, STR_T_LITERAL(""));
+    TEST_ASSERT_NOT_NULL(empty.str);
+    TEST_ASSERT_EQUAL_UINT32(0, empty.len);
+    TEST_ASSERT_EQUAL_PTR(empty.str, strngr_intern(&pool, STR_T_LITERAL("")).str);
+    TEST_ASSERT_NULL(strngr_intern(&pool, null_str).str);
+}
+
+void test_strngr_intern_full(void)
+{
+    static uint64_t block[256];
+    strngr_arena_t arena;
+    strngr_intern_t pool;
+    char key[4] = "k";
+    strngr_arena_init(&arena, block, sizeof(block), 0U);
+    strngr_intern_init(&pool, &arena, 16, 0U);
+
+    // 16 slots hold at most 14 strings
+    for (uint32_t i = 0; i < 14; i++)
+    {
+        key[1] = (char)('a' + i);
+        str_t k = {2, 2, key, 0U};
+        TEST_ASSERT_NOT_NULL(strngr_intern(&pool, k).str);
+    }
+    TEST_ASSERT_NULL(strngr_intern(&pool, STR_T_LITERAL("new")).str);
+
+    // Strings already in the pool are still returned
+    TEST_ASSERT_NOT_NULL(strngr_intern(&pool, STR_T_LITERAL("ka")).str);
+}
+
+// ============================================================================
+// Tests for strngr_split
+// ============================================================================
+
+static uint32_t split_collect(strngr_split_iter_t *it, str_view_t *out, uint32_t cap)
+{
+    uint32_t n = 0;
+    while ((n < cap) && strngr_split_next(it, &out[n]))
+    {
+        n++;
+    }
+    return n;
+}
+
+void test_strngr_split_init_invalid(void)
+{
+    strngr_split_iter_t it;
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    TEST_ASSERT_NULL(strngr_split_init(NULL, STR_T_LITERAL("a,b"), STR_T_LITERAL(","), 0U));
+    TEST_ASSERT_NULL(strngr_split_init(&it, null_str, STR_T_LITERAL(","), 0U));
+    TEST_ASSERT_NULL(strngr_split_init(&it, STR_T_LITERAL("a,b"), STR_T_LITERAL(""), 0U));
+    TEST_ASSERT_NULL(strngr_split_init_set(&it, STR_T_LITERAL("a,b"), null_str, 0U));
+}
+
+void test_strngr_split_single_byte(void)
+{
+    strngr_split_iter_t it;
+    str_view_t tok[8];
+    str_t src = STR_T_LITERAL("a,bb,,ccc,");
+
+    strngr_split_init(&it, src, STR_T_LITERAL(","), 0U);
+    TEST_ASSERT_EQUAL_UINT32(5, split_collect(&it, tok, 8));
+    TEST_ASSERT_EQUAL_PTR(src.str, tok[0].str);
+    TEST_ASSERT_EQUAL_UINT32(1, tok[0].len);
+    TEST_ASSERT_EQUAL_MEMORY("bb", tok[1].str, 2);
+    TEST_ASSERT_EQUAL_UINT32(0, tok[2].len);
+    TEST_ASSERT_EQUAL_MEMORY("ccc", tok[3].str, 3);
+    TEST_ASSERT_EQUAL_UINT32(0, tok[4].len);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_split_next(&it, tok));
+}
+
+void test_strngr_split_skip_empty(void)
+{
+    strngr_split_iter_t it;
+    str_view_t tok[8];
+
+    strngr_split_init(&it, STR_T_LITERAL(",,a,,b,,"), STR_T_LITERAL(","), STRNGR_SPLIT_SKIP_EMPTY);
+    TEST_ASSERT_EQUAL_UINT32(2, split_collect(&it, tok, 8));
+    TEST_ASSERT_EQUAL_MEMORY("a", tok[0].str, 1);
+    TEST_ASSERT_EQUAL_MEMORY("b", tok[1].str, 1);
+
+    // An empty input is one empty token, or none when skipping
+    strngr_split_init(&it, STR_T_LITERAL(""), STR_T_LITERAL(","), 0U);
+    TEST_ASSERT_EQUAL_UINT32(1, split_collect(&it, tok, 8));
+    strngr_split_init(&it, STR_T_LITERAL(""), STR_T_LITERAL(","), STRNGR_SPLIT_SKIP_EMPTY);
+    TEST_ASSERT_EQUAL_UINT32(0, split_collect(&it, tok, 8));
+}
+
+void test_strngr_split_byte_set(void)
+{
+    strngr_split_iter_t it;
+    str_view_t tok[8];
+
+    // Small set, with separators beyond the first 32 bytes
+    strngr_split_init_set(&it, STR_T_LITERAL("key=value; path=/usr/local/share/doc/strngr;x y"), STR_T_LITERAL("; "),
+                          STRNGR_SPLIT_SKIP_EMPTY);
+    TEST_ASSERT_EQUAL_UINT32(4, split_collect(&it, tok, 8));
+    TEST_ASSERT_EQUAL_MEMORY("key=value", tok[0].str, 9);
+    TEST_ASSERT_EQUAL_UINT32(32, tok[1].len);
+    TEST_ASSERT_EQUAL_MEMORY("x", tok[2].str, 1);
+    TEST_ASSERT_EQUAL_MEMORY("y", tok[3].str, 1);
+
+    // More than four separators
+    strngr_split_init_set(&it, STR_T_LITERAL("a.b-c_d/e:f"), STR_T_LITERAL(".-_/:"), 0U);
+    TEST_ASSERT_EQUAL_UINT32(6, split_collect(&it, tok, 8));
+    TEST_ASSERT_EQUAL_MEMORY("f", tok[5].str, 1);
+}
+
+void test_strngr_split_multi_byte(void)
+{
+    strngr_split_iter_t it;
+    str_view_t tok[8];
+
+    strngr_split_init(&it, STR_T_LITERAL("one\r\ntwo\r\n\r\nthree"), STR_T_LITERAL("\r\n"), 0U);
+    TEST_ASSERT_EQUAL_UINT32(4, split_collect(&it, tok, 8));
+    TEST_ASSERT_EQUAL_MEMORY("one", tok[0].str, 3);
+    TEST_ASSERT_EQUAL_MEMORY("two", tok[1].str, 3);
+    TEST_ASSERT_EQUAL_UINT32(0, tok[2].len);
+    TEST_ASSERT_EQUAL_UINT32(5, tok[3].len);
+    TEST_ASSERT_EQUAL_MEMORY("three", tok[3].str, 5);
+}
+
+void test_strngr_split_quoted(void)
+{
+    strngr_split_iter_t it;
+    str_view_t tok[8];
+
+    strngr_split_init(&it, STR_T_LITERAL("a,\"b,c\",\"\"\"d,\"\"\",e"), STR_T_LITERAL(","), STRNGR_SPLIT_QUOTED);
+    TEST_ASSERT_EQUAL_UINT32(4, split_collect(&it, tok, 8));
+    TEST_ASSERT_EQUAL_MEMORY("\"b,c\"", tok[1].str, 5);
+    TEST_ASSERT_EQUAL_UINT32(5, tok[1].len);
+    TEST_ASSERT_EQUAL_MEMORY("\"\"\"d,\"\"\"", tok[2].str, 8);
+    TEST_ASSERT_EQUAL_MEMORY("e", tok[3].str, 1);
+
+    // Unterminated quote runs to the end; the quote byte can be changed
+    strngr_split_init(&it, STR_T_LITERAL("x 'y z"), STR_T_LITERAL(" "), STRNGR_SPLIT_QUOTED);
+    it.quote = '\'';
+    TEST_ASSERT_EQUAL_UINT32(2, split_collect(&it, tok, 8));
+    TEST_ASSERT_EQUAL_MEMORY("'y z", tok[1].str, 4);
+}
+
+void test_strngr_split_all(void)
+{
+    strngr_split_iter_t it;
+    str_view_t tok[2];
+
+    strngr_view_split_init(&it, STR_VIEW_LITERAL("a b c d e"), STR_VIEW_LITERAL(" "), 0U);
+    TEST_ASSERT_EQUAL_UINT32(2, strngr_split_all(&it, tok, 2));
+    TEST_ASSERT_EQUAL_MEMORY("b", tok[1].str, 1);
+    TEST_ASSERT_EQUAL_UINT32(2, strngr_split_all(&it, tok, 2));
+    TEST_ASSERT_EQUAL_MEMORY("c", tok[0].str, 1);
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_split_all(&it, tok, 2));
+    TEST_ASSERT_EQUAL_MEMORY("e", tok[0].str, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_split_all(&it, tok, 2));
+}
+
+// ============================================================================
+// Tests for strngr_lines
+// ============================================================================
+
+void test_strngr_lines_basic(void)
+{
+    strngr_lines_t it;
+    str_view_t line = {NULL, 0U};
+    str_t src = STR_T_LITERAL("first\n\nthird\nlast");
+
+    TEST_ASSERT_EQUAL_PTR(&it, strngr_lines_init(&it, src, 0U));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_lines_next(&it, &line));
+    TEST_ASSERT_EQUAL_PTR(src.str, line.str);
+    TEST_ASSERT_EQUAL_UINT32(5, line.len);
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_lines_next(&it, &line));
+    TEST_ASSERT_EQUAL_UINT32(0, line.len);
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_lines_next(&it, &line));
+    TEST_ASSERT_EQUAL_MEMORY("third", line.str, 5);
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_lines_next(&it, &line));
+    TEST_ASSERT_EQUAL_UINT32(4, line.len);
+    TEST_ASSERT_EQUAL_MEMORY("last", line.str, 4);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_lines_next(&it, &line));
+}
+
+void test_strngr_lines_trailing_newline(void)
+{
+    strngr_lines_t it;
+    str_view_t line = {NULL, 0U};
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    // A final newline does not start another line, and empty input has none
+    strngr_lines_init(&it, STR_T_LITERAL("a\n"), 0U);
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_lines_next(&it, &line));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_lines_next(&it, &line));
+
+    strngr_lines_init(&it, STR_T_LITERAL(""), 0U);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_lines_next(&it, &line));
+    TEST_ASSERT_NULL(strngr_lines_init(&it, null_str, 0U));
+}
+
+void test_strngr_lines_strip_cr(void)
+{
+    strngr_lines_t it;
+    str_view_t line = {NULL, 0U};
+
+    strngr_lines_init(&it, STR_T_LITERAL("a\r\nb\n\r\nc\r"), STRNGR_LINES_STRIP_CR);
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_lines_next(&it, &line));
+    TEST_ASSERT_EQUAL_UINT32(1, line.len);
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_lines_next(&it, &line));
+    TEST_ASSERT_EQUAL_UINT32(1, line.len);
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_lines_next(&it, &line));
+    TEST_ASSERT_EQUAL_UINT32(0, line.len);
+
+    // Only a CR in front of a newline is stripped
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_lines_next(&it, &line));
+    TEST_ASSERT_EQUAL_UINT32(2, line.len);
+}
+
+void test_strngr_lines_long_buffer(void)
+{
+    static char buf[1000];
+    strngr_lines_t it;
+    str_view_t line = {NULL, 0U};
+    uint32_t n = 0;
+
+    // Lines of increasing length cross the 64-byte blocks, including blocks full of newlines
+    uint32_t len = 0;
+    for (uint32_t k = 0; (len + k + 1U) <= 900U; k = (k + 1U) % 40U)
+    {
+        memset(&buf[len], 'x', k);
+        buf[len + k] = '\n';
+        len += k + 1U;
+        n++;
+    }
+    str_t src = {sizeof(buf), len, buf, 0U};
+
+    strngr_lines_init(&it, src, 0U);
+    uint32_t seen = 0;
+    uint32_t pos = 0;
+    while (strngr_lines_next(&it, &line))
+    {
+        TEST_ASSERT_EQUAL_PTR(&buf[pos], line.str);
+        TEST_ASSERT_EQUAL_UINT32(seen % 40U, line.len);
+        pos += line.len + 1U;
+        seen++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(n, seen);
+    TEST_ASSERT_EQUAL_UINT32(n, strngr_count_lines(src));
+}
+
+void test_strngr_count_lines(void)
+{
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_count_lines(null_str));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_count_lines(STR_T_LITERAL("")));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_count_lines(STR_T_LITERAL("a")));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_count_lines(STR_T_LITERAL("a\n")));
+    TEST_ASSERT_EQUAL_UINT32(2, strngr_count_lines(STR_T_LITERAL("\n\n")));
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_view_count_lines(STR_VIEW_LITERAL("a\nb\r\nc")));
+}
+
+// ============================================================================
+// Tests for strngr_map_file
+// ============================================================================
+
+static const char *write_temp_file(const char *contents, size_t len)
+{
+    static const char path[] = "strngr_map_file_test.tmp";
+    FILE *f = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL_UINT32(len, fwrite(contents, 1, len, f));
+    fclose(f);
+    return path;
+}
+
+void test_strngr_map_file(void)
+{
+    strngr_file_t file;
+    const char *path = write_temp_file("alpha\nbeta\ngamma\n", 17);
+
+    TEST_ASSERT_EQUAL_PTR(&file, strngr_map_file(&file, path, STRNGR_FILE_SEQUENTIAL | STRNGR_FILE_WILLNEED));
+    TEST_ASSERT_EQUAL_UINT32(17, strngr_strlen(file.view));
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_count_lines(file.view));
+    TEST_ASSERT_EQUAL_MEMORY("gamma", strngr_strstr(file.view, STR_T_LITERAL("gam")).str, 5);
+
+    strngr_unmap_file(&file);
+    TEST_ASSERT_NULL(file.view.str);
+    remove(path);
+}
+
+void test_strngr_map_file_empty(void)
+{
+    strngr_file_t file;
+    const char *path = write_temp_file("", 0);
+
+    TEST_ASSERT_EQUAL_PTR(&file, strngr_map_file(&file, path, STRNGR_FILE_HUGEPAGE));
+    TEST_ASSERT_NOT_NULL(file.view.str);
+    TEST_ASSERT_EQUAL_UINT32(0, file.view.len);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_file_window(&file, 0).len);
+
+    strngr_unmap_file(&file);
+    remove(path);
+}
+
+void test_strngr_map_file_errors(void)
+{
+    strngr_file_t file;
+
+    TEST_ASSERT_NULL(strngr_map_file(NULL, "strngr_map_file_test.tmp", 0U));
+    TEST_ASSERT_NULL(strngr_map_file(&file, NULL, 0U));
+    TEST_ASSERT_NULL(strngr_map_file(&file, "strngr_no_such_file.tmp", 0U));
+    TEST_ASSERT_NULL(file.view.str);
+
+    // Directories are not regular files
+    TEST_ASSERT_NULL(strngr_map_file(&file, ".", 0U));
+
+    // Unmapping a failed or cleared file is harmless
+    strngr_unmap_file(&file);
+    strngr_unmap_file(NULL);
+}
+
+void test_strngr_file_window(void)
+{
+    strngr_file_t file;
+    const char *path = write_temp_file("0123456789", 10);
+
+    strngr_map_file(&file, path, 0U);
+    str_view_t w = strngr_file_window(&file, 4);
+    TEST_ASSERT_EQUAL_UINT32(6, w.len);
+    TEST_ASSERT_EQUAL_MEMORY("456789", w.str, 6);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_file_window(&file, 10).len);
+    TEST_ASSERT_NULL(strngr_file_window(&file, 11).str);
+
+    strngr_unmap_file(&file);
+    remove(path);
+}
+
+// ============================================================================
+// Tests for strngr_stream
+// ============================================================================
+
+typedef struct
+{
+    strngr_stream_match_t matches[16];
+    uint32_t count;
+    uint32_t stop_after;
+} stream_collect_t;
+
+static uint32_t stream_collect(void *ctx, const strngr_stream_match_t *match)
+{
+    stream_collect_t *c = (stream_collect_t *)ctx;
+    c->matches[c->count] = *match;
+    c->count++;
+    return (c->count == c->stop_after) ? 1U : 0U;
+}
+
+void test_strngr_stream_init(void)
+{
+    strngr_stream_t st;
+    strngr_needle_t needle;
+    char mem[8];
+    strngr_needle_compile(&needle, STR_T_LITERAL("needle"));
+
+    TEST_ASSERT_EQUAL_UINT32(10, strngr_stream_mem_required(6));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_stream_mem_required(1));
+    TEST_ASSERT_NULL(strngr_stream_init(&st, &needle, mem, sizeof(mem)));
+    TEST_ASSERT_NULL(strngr_stream_init(NULL, &needle, mem, sizeof(mem)));
+
+    // Single-byte needles need no carry memory
+    strngr_needle_compile(&needle, STR_T_LITERAL("x"));
+    TEST_ASSERT_EQUAL_PTR(&st, strngr_stream_init(&st, &needle, NULL, 0U));
+
+    // Needles too long to size carry memory for are rejected, not treated as needing none
+    const uint32_t huge = (UINT32_MAX / 2U) + 2U;
+    strngr_multi_t multi;
+    memset(&multi, 0, sizeof(multi));
+    needle.pattern = (str_t){huge, huge, mem, 0U};
+    multi.patterns = &needle.pattern;
+    multi.count    = 1U;
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_stream_mem_required(huge));
+    TEST_ASSERT_NULL(strngr_stream_init(&st, &needle, NULL, 0U));
+    TEST_ASSERT_NULL(strngr_stream_init_multi(&st, &multi, NULL, 0U));
+}
+
+void test_strngr_stream_across_chunks(void)
+{
+    strngr_stream_t st;
+    strngr_needle_t needle;
+    char mem[16];
+    stream_collect_t c = {{{0U, 0U}}, 0U, 0U};
+    strngr_needle_compile(&needle, STR_T_LITERAL("needle"));
+    strngr_stream_init(&st, &needle, mem, sizeof(mem));
+
+    // Matches inside a chunk, straddling one boundary, and spread over three chunks
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_stream_feed(&st, STR_T_LITERAL("a needle, nee"), stream_collect, &c));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_stream_feed(&st, STR_T_LITERAL("dle and ne"), stream_collect, &c));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_stream_feed(&st, STR_T_LITERAL("e"), stream_collect, &c));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_stream_feed(&st, STR_T_LITERAL("dle"), stream_collect, &c));
+
+    TEST_ASSERT_EQUAL_UINT32(3, c.count);
+    TEST_ASSERT_TRUE(c.matches[0].offset == 2U);
+    TEST_ASSERT_TRUE(c.matches[1].offset == 10U);
+    TEST_ASSERT_TRUE(c.matches[2].offset == 21U);
+    TEST_ASSERT_TRUE(st.consumed == 27U);
+    TEST_ASSERT_TRUE(st.carry <= 5U);
+}
+
+void test_strngr_stream_overlapping(void)
+{
+    strngr_stream_t st;
+    strngr_needle_t needle;
+    char mem[4];
+    stream_collect_t c = {{{0U, 0U}}, 0U, 0U};
+    strngr_needle_compile(&needle, STR_T_LITERAL("aaa"));
+    strngr_stream_init(&st, &needle, mem, sizeof(mem));
+
+    strngr_stream_feed(&st, STR_T_LITERAL("aa"), stream_collect, &c);
+    strngr_stream_feed(&st, STR_T_LITERAL("aa"), stream_collect, &c);
+    strngr_stream_feed(&st, STR_T_LITERAL("a"), stream_collect, &c);
+
+    TEST_ASSERT_EQUAL_UINT32(3, c.count);
+    TEST_ASSERT_TRUE(c.matches[0].offset == 0U);
+    TEST_ASSERT_TRUE(c.matches[2].offset == 2U);
+}
+
+void test_strngr_stream_multi(void)
+{
+    static uint64_t arena[1024];
+    strngr_multi_t multi;
+    strngr_stream_t st;
+    char mem[16];
+    stream_collect_t c = {{{0U, 0U}}, 0U, 0U};
+    const str_t patterns[] = {STR_T_LITERAL("error"), STR_T_LITERAL("warn")};
+    strngr_multi_compile(&multi, patterns, 2, arena, sizeof(arena));
+    TEST_ASSERT_EQUAL_PTR(&st, strngr_stream_init_multi(&st, &multi, mem, sizeof(mem)));
+
+    strngr_stream_feed(&st, STR_T_LITERAL("ok err"), stream_collect, &c);
+    strngr_stream_feed(&st, STR_T_LITERAL("or; wa"), stream_collect, &c);
+    strngr_stream_feed(&st, STR_T_LITERAL("rn"), stream_collect, &c);
+
+    TEST_ASSERT_EQUAL_UINT32(2, c.count);
+    TEST_ASSERT_EQUAL_UINT32(0, c.matches[0].pattern);
+    TEST_ASSERT_TRUE(c.matches[0].offset == 3U);
+    TEST_ASSERT_EQUAL_UINT32(1, c.matches[1].pattern);
+    TEST_ASSERT_TRUE(c.matches[1].offset == 10U);
+}
+
+void test_strngr_stream_stop(void)
+{
+    strngr_stream_t st;
+    strngr_needle_t needle;
+    char mem[4];
+    stream_collect_t c = {{{0U, 0U}}, 0U, 1U};
+    strngr_needle_compile(&needle, STR_T_LITERAL("ab"));
+    strngr_stream_init(&st, &needle, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_stream_feed(&st, STR_T_LITERAL("ab ab"), stream_collect, &c));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_stream_feed(&st, STR_T_LITERAL("ab"), stream_collect, &c));
+    TEST_ASSERT_EQUAL_UINT32(1, c.count);
+}
+
+// ============================================================================
+// Tests for strngr_par
+// ============================================================================
+
+static char par_hay[1U << 20];
+
+static str_t par_fill(void)
+{
+    for (uint32_t i = 0; i < sizeof(par_hay); i++)
+    {
+        par_hay[i] = (char)('a' + (i % 7U));
+    }
+
+    // Plant needles at the start, at chunk boundaries and at the very end
+    static const uint32_t at[] = {0U, 65530U, 131072U, 500000U, (1U << 20) - 6U};
+    for (uint32_t k = 0; k < 5; k++)
+    {
+        memcpy(&par_hay[at[k]], "NEEDLE", 6);
+    }
+
+    str_t hay = {sizeof(par_hay), sizeof(par_hay), par_hay, 0U};
+    return hay;
+}
+
+/* Caller-supplied executor: runs the tasks in reverse order on the calling thread */
+static void par_reverse_run(void *pool, strngr_par_task_t fn, void *arg, const uint32_t count)
+{
+    (*(uint32_t *)pool)++;
+    for (uint32_t i = count; i > 0U; i--)
+    {
+        fn(arg, i - 1U);
+    }
+}
+
+void test_strngr_par_serial(void)
+{
+    strngr_needle_t needle;
+    uint32_t out[8];
+    str_t hay = par_fill();
+    strngr_needle_compile(&needle, STR_T_LITERAL("NEEDLE"));
+
+    // Without an executor everything runs on the calling thread
+    TEST_ASSERT_EQUAL_PTR(par_hay, strngr_par_find_first(NULL, hay, &needle).str);
+    TEST_ASSERT_EQUAL_UINT32(5, strngr_par_count(NULL, hay, &needle));
+    TEST_ASSERT_EQUAL_UINT32(5, strngr_par_find_all(NULL, hay, &needle, out, 8));
+    TEST_ASSERT_EQUAL_UINT32(65530, out[1]);
+    TEST_ASSERT_EQUAL_UINT32((1U << 20) - 6U, out[4]);
+}
+
+void test_strngr_par_pool(void)
+{
+    strngr_par_pool_t pool;
+    strngr_needle_t needle;
+    uint32_t out[3];
+    str_t hay = par_fill();
+    strngr_needle_compile(&needle, STR_T_LITERAL("NEEDLE"));
+
+    TEST_ASSERT_EQUAL_PTR(&pool, strngr_par_pool_init(&pool, 4));
+    strngr_par_exec_t exec = strngr_par_pool_exec(&pool);
+    TEST_ASSERT_EQUAL_UINT32(4, exec.threads);
+
+    // Matches straddling chunk boundaries are found once, and output is in ascending order
+    TEST_ASSERT_EQUAL_UINT32(5, strngr_par_count(&exec, hay, &needle));
+    TEST_ASSERT_EQUAL_UINT32(5, strngr_par_find_all(&exec, hay, &needle, out, 3));
+    TEST_ASSERT_EQUAL_UINT32(0, out[0]);
+    TEST_ASSERT_EQUAL_UINT32(65530, out[1]);
+    TEST_ASSERT_EQUAL_UINT32(131072, out[2]);
+
+    // Leftmost match wins, even once the first one is removed
+    par_hay[0] = 'x';
+    TEST_ASSERT_EQUAL_PTR(&par_hay[65530], strngr_par_find_first(&exec, hay, &needle).str);
+
+    strngr_par_pool_destroy(&pool);
+}
+
+void test_strngr_par_custom_executor(void)
+{
+    strngr_needle_t needle;
+    uint32_t calls = 0;
+    str_t hay = par_fill();
+    strngr_par_exec_t exec = {par_reverse_run, &calls, 8U};
+    strngr_needle_compile(&needle, STR_T_LITERAL("NEEDLE"));
+
+    TEST_ASSERT_EQUAL_PTR(par_hay, strngr_par_find_first(&exec, hay, &needle).str);
+    TEST_ASSERT_EQUAL_UINT32(5, strngr_par_count(&exec, hay, &needle));
+    TEST_ASSERT_EQUAL_UINT32(2, calls);
+}
+
+void test_strngr_par_no_match(void)
+{
+    strngr_needle_t needle;
+    str_t hay = par_fill();
+    str_t null_str = {0U, 0U, NULL, 0U};
+    strngr_needle_compile(&needle, STR_T_LITERAL("MISSING"));
+
+    TEST_ASSERT_NULL(strngr_par_find_first(NULL, hay, &needle).str);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_par_count(NULL, hay, &needle));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_par_find_all(NULL, null_str, &needle, NULL, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_par_count(NULL, hay, NULL));
+}
+
+void test_strngr_par_periodic_needle(void)
+{
+    strngr_par_pool_t pool;
+    strngr_needle_t needle;
+    uint32_t out[4];
+    str_t hay = {sizeof(par_hay), sizeof(par_hay), par_hay, 0U};
+    str_t run = {100000U, 100000U, par_hay, 0U};
+    const uint32_t total = sizeof(par_hay) - 100000U + 1U;
+
+    // A long run of one byte matches at every offset; each match must not re-verify the whole needle
+    memset(par_hay, 'a', sizeof(par_hay));
+    strngr_needle_compile(&needle, run);
+    TEST_ASSERT_EQUAL_UINT32(total, strngr_find_all_compiled(hay, &needle, NULL, 0U, STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(total, strngr_par_count(NULL, hay, &needle));
+
+    TEST_ASSERT_EQUAL_PTR(&pool, strngr_par_pool_init(&pool, 4));
+    strngr_par_exec_t exec = strngr_par_pool_exec(&pool);
+    TEST_ASSERT_EQUAL_UINT32(total, strngr_par_find_all(&exec, hay, &needle, out, 4));
+    TEST_ASSERT_EQUAL_UINT32(0, out[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, out[3]);
+    strngr_par_pool_destroy(&pool);
+}
+
+// ============================================================================
+// Tests for strngr_count
+// ============================================================================
+
+void test_strngr_count_basic(void)
+{
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_count(STR_T_LITERAL("aaaa"), STR_T_LITERAL("aa"), STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(2, strngr_count(STR_T_LITERAL("aaaa"), STR_T_LITERAL("aa"), STRNGR_NON_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(2, strngr_count(STR_T_LITERAL("abcabc"), STR_T_LITERAL("abc"), STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(4, strngr_count(STR_T_LITERAL("banana"), STR_T_LITERAL("a"), STRNGR_NON_OVERLAPPING)
+                                    + strngr_count(STR_T_LITERAL("banana"), STR_T_LITERAL("n"), STRNGR_OVERLAPPING)
+                                    - 1U);
+    TEST_ASSERT_EQUAL_UINT32(2, strngr_view_count(STR_VIEW_LITERAL("banana"), STR_VIEW_LITERAL("ana"),
+                                                  STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_view_count(STR_VIEW_LITERAL("banana"), STR_VIEW_LITERAL("ana"),
+                                                  STRNGR_NON_OVERLAPPING));
+
+    // Empty or missing needles and needles longer than the haystack match nothing
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_count(STR_T_LITERAL("abc"), STR_T_LITERAL(""), STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_count(STR_T_LITERAL("abc"), null_str, STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_count(null_str, STR_T_LITERAL("a"), STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_count(STR_T_LITERAL("ab"), STR_T_LITERAL("abc"), STRNGR_OVERLAPPING));
+}
+
+void test_strngr_count_byte_long(void)
+{
+    static char buf[1000];
+
+    // Every seventh byte is a match, spread over full 64-byte blocks and a tail
+    for (uint32_t i = 0; i < sizeof(buf); i++)
+    {
+        buf[i] = ((i % 7U) == 3U) ? 'z' : 'y';
+    }
+    str_t hay = {sizeof(buf), 999U, buf, 0U};
+
+    TEST_ASSERT_EQUAL_UINT32(143, strngr_count(hay, STR_T_LITERAL("z"), STRNGR_NON_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(856, strngr_count(hay, STR_T_LITERAL("y"), STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(143, strngr_count(hay, STR_T_LITERAL("yzy"), STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(427, strngr_count(hay, STR_T_LITERAL("yy"), STRNGR_NON_OVERLAPPING));
+}
+
+void test_strngr_find_all_offsets(void)
+{
+    uint32_t out[8];
+
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_find_all(STR_T_LITERAL("aaaa"), STR_T_LITERAL("aa"), out, 8U,
+                                                STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(0, out[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, out[1]);
+    TEST_ASSERT_EQUAL_UINT32(2, out[2]);
+
+    TEST_ASSERT_EQUAL_UINT32(2, strngr_find_all(STR_T_LITERAL("aaaa"), STR_T_LITERAL("aa"), out, 8U,
+                                                STRNGR_NON_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(0, out[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, out[1]);
+
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_view_find_all(STR_VIEW_LITERAL("a,b,c,"), STR_VIEW_LITERAL(","), out, 8U,
+                                                     STRNGR_NON_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(1, out[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, out[1]);
+    TEST_ASSERT_EQUAL_UINT32(5, out[2]);
+}
+
+void test_strngr_find_all_cap(void)
+{
+    uint32_t out[4] = {0U, 0U, 0U, 0U};
+
+    // The total is returned, but only cap offsets are written
+    TEST_ASSERT_EQUAL_UINT32(5, strngr_find_all(STR_T_LITERAL("x.x.x.x.x"), STR_T_LITERAL("x"), out, 2U,
+                                                STRNGR_NON_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(0, out[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, out[1]);
+    TEST_ASSERT_EQUAL_UINT32(0, out[2]);
+
+    // Counting only, without an output array
+    TEST_ASSERT_EQUAL_UINT32(4, strngr_find_all(STR_T_LITERAL("x.x.x.x.x"), STR_T_LITERAL("x.x"), NULL, 0U,
+                                                STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_find_all(STR_T_LITERAL("x.x"), STR_T_LITERAL("x"), NULL, 4U,
+                                                STRNGR_OVERLAPPING));
+}
+
+void test_strngr_find_all_periodic_needle(void)
+{
+    static char run[4096];
+    static uint32_t out[4096];
+    char hay[] = "abcabcabcabcabXabcabcabcabcabcaabcabcab";
+    char needle[] = "abcabcab";
+    uint32_t want[16];
+    uint32_t count = 0U;
+
+    // Runs of overlapping matches, broken runs and a near miss one byte short of a period
+    for (uint32_t i = 0; (i + 8U) <= (sizeof(hay) - 1U); i++)
+    {
+        if (memcmp(&hay[i], needle, 8U) == 0)
+        {
+            want[count++] = i;
+        }
+    }
+    str_t h = {sizeof(hay) - 1U, sizeof(hay) - 1U, hay, 0U};
+    str_t n = {8U, 8U, needle, 0U};
+    TEST_ASSERT_EQUAL_UINT32(count, strngr_find_all(h, n, out, 16U, STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(want, out, count);
+
+    // A run of one repeated byte matches at every offset
+    memset(run, 'a', sizeof(run));
+    str_t long_h = {sizeof(run), sizeof(run), run, 0U};
+    str_t long_n = {64U, 64U, run, 0U};
+    TEST_ASSERT_EQUAL_UINT32(4033, strngr_find_all(long_h, long_n, out, 4096U, STRNGR_OVERLAPPING));
+    TEST_ASSERT_EQUAL_UINT32(0, out[0]);
+    TEST_ASSERT_EQUAL_UINT32(4032, out[4032]);
+    TEST_ASSERT_EQUAL_UINT32(64, strngr_find_all(long_h, long_n, NULL, 0U, STRNGR_NON_OVERLAPPING));
+}
+
+// ============================================================================
+// Tests for strngr_strrchr / strngr_strrstr
+// ============================================================================
+
+void test_strngr_strrchr_basic(void)
+{
+    str_t path     = STR_T_LITERAL("/usr/local/lib/file.tar.gz");
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    TEST_ASSERT_EQUAL_PTR(&path.str[14], strngr_strrchr(path, '/'));
+    TEST_ASSERT_EQUAL_PTR(&path.str[23], strngr_strrchr(path, '.'));
+    TEST_ASSERT_NULL(strngr_strrchr(path, '?'));
+    TEST_ASSERT_NULL(strngr_strrchr(null_str, '/'));
+    TEST_ASSERT_NULL(strngr_strrchr(STR_T_LITERAL(""), '/'));
+
+    // Bytes past len are not part of the string
+    path.len = 14;
+    TEST_ASSERT_EQUAL_PTR(&path.str[10], strngr_strrchr(path, '/'));
+}
+
+void test_strngr_strrchr_long_string_every_position(void)
+{
+    char buf[200];
+    str_t src = {sizeof(buf), sizeof(buf), buf, 0U};
+
+    for (uint32_t i = 0; i < sizeof(buf); i++)
+    {
+        memset(buf, 'a', sizeof(buf));
+        buf[0] = 'z';
+        buf[i] = 'z';
+        TEST_ASSERT_EQUAL_PTR(&buf[i], strngr_strrchr(src, 'z'));
+        TEST_ASSERT_EQUAL_PTR((i == (sizeof(buf) - 1)) ? &buf[sizeof(buf) - 2] : &buf[sizeof(buf) - 1],
+                              strngr_strrchr(src, 'a'));
+    }
+
+    // High-bit bytes compare as bytes, not as negative chars
+    memset(buf, 'a', sizeof(buf));
+    buf[37] = (char)0xFF;
+    TEST_ASSERT_EQUAL_PTR(&buf[37], strngr_strrchr(src, (char)0xFF));
+}
+
+void test_strngr_strrstr_basic(void)
+{
+    char  hay[]    = "key=1; key=2; key=3";
+    str_t h        = {19, 19, hay, 0U};
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    str_t result = strngr_strrstr(h, STR_T_LITERAL("key="));
+    TEST_ASSERT_EQUAL_PTR(&hay[14], result.str);
+    TEST_ASSERT_EQUAL_UINT32(5, result.len);
+    TEST_ASSERT_EQUAL_UINT32(5, result.max_len);
+
+    TEST_ASSERT_EQUAL_PTR(&hay[18], strngr_strrstr(h, STR_T_LITERAL("3")).str);
+    TEST_ASSERT_EQUAL_PTR(&hay[0], strngr_strrstr(h, STR_T_LITERAL("key=1")).str);
+    TEST_ASSERT_NULL(strngr_strrstr(h, STR_T_LITERAL("key=4")).str);
+    TEST_ASSERT_NULL(strngr_strrstr(STR_T_LITERAL("ab"), STR_T_LITERAL("abc")).str);
+    TEST_ASSERT_NULL(strngr_strrstr(null_str, STR_T_LITERAL("a")).str);
+    TEST_ASSERT_NULL(strngr_strrstr(h, null_str).str);
+
+    // An empty needle matches at the end
+    result = strngr_strrstr(h, STR_T_LITERAL(""));
+    TEST_ASSERT_EQUAL_PTR(&hay[19], result.str);
+    TEST_ASSERT_EQUAL_UINT32(0, result.len);
+
+    // Overlapping occurrences: the one starting last wins
+    TEST_ASSERT_EQUAL_UINT32(2, strngr_strrstr(STR_T_LITERAL("aaaa"), STR_T_LITERAL("aa")).len);
+}
+
+void test_strngr_strrstr_matches_naive(void)
+{
+    static char hay[1000];
+    const char *patterns[] = {"x", "ab", "abcab", "cabca", "Content-Length",
+                              "0123456789012345678901234567890123456789xyz", "abcabcabcabcabcabcabcabcabcabcabcabcabc"};
+
+    for (uint32_t i = 0; i < sizeof(hay); i++)
+    {
+        hay[i] = (char)('a' + (i % 3));
+    }
+    memcpy(&hay[100], patterns[4], 14);
+    memcpy(&hay[50], patterns[5], 43);
+    str_t h = {sizeof(hay), sizeof(hay), hay, 0U};
+
+    for (uint32_t p = 0; p < 7; p++)
+    {
+        const uint32_t nl = (uint32_t)strlen(patterns[p]);
+        str_t          n  = {nl, nl, (char *)patterns[p], 0U};
+
+        const char *expected = NULL;
+        for (uint32_t i = 0; (i + nl) <= sizeof(hay); i++)
+        {
+            if (memcmp(&hay[i], patterns[p], nl) == 0)
+            {
+                expected = &hay[i];
+            }
+        }
+
+        TEST_ASSERT_EQUAL_PTR(expected, strngr_strrstr(h, n).str);
+    }
+}
+
+void test_strngr_strrstr_adversarial(void)
+{
+    static char hay[4096];
+    char needle[48];
+    memset(hay, 'a', sizeof(hay));
+    memset(needle, 'a', sizeof(needle));
+    str_t h = {sizeof(hay), sizeof(hay), hay, 0U};
+    str_t n = {sizeof(needle), sizeof(needle), needle, 0U};
+
+    // Mismatch at the front of the needle, which a backward scan checks last
+    needle[0] = 'b';
+    TEST_ASSERT_NULL(strngr_strrstr(h, n).str);
+    n.len = 12;
+    TEST_ASSERT_NULL(strngr_strrstr(h, n).str);
+
+    // Mismatch in the middle, and a single real match near the start
+    needle[0] = 'a';
+    needle[5] = 'b';
+    TEST_ASSERT_NULL(strngr_strrstr(h, n).str);
+    hay[105] = 'b';
+    TEST_ASSERT_EQUAL_PTR(&hay[100], strngr_strrstr(h, n).str);
+    n.len = sizeof(needle);
+    TEST_ASSERT_EQUAL_PTR(&hay[100], strngr_strrstr(h, n).str);
+}
+
+void test_strngr_view_strrchr_and_strrstr(void)
+{
+    str_view_t path = STR_VIEW_LITERAL("/srv/www/index.html");
+
+    TEST_ASSERT_EQUAL_PTR(&path.str[8], strngr_view_strrchr(path, '/'));
+    TEST_ASSERT_NULL(strngr_view_strrchr(path, '\\'));
+
+    str_view_t ext = strngr_view_strrstr(path, STR_VIEW_LITERAL(".ht"));
+    TEST_ASSERT_EQUAL_PTR(&path.str[14], ext.str);
+    TEST_ASSERT_EQUAL_UINT32(5, ext.len);
+    TEST_ASSERT_NULL(strngr_view_strrstr(path, STR_VIEW_LITERAL(".php")).str);
+}
+
+// ============================================================================
+// Tests for strngr_byteset_t / strngr_strspn / strngr_strcspn_set / strngr_strpbrk
+// ============================================================================
+
+void test_strngr_byteset_compile(void)
+{
+    strngr_byteset_t set;
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    TEST_ASSERT_NULL(strngr_byteset_compile(NULL, STR_T_LITERAL(",")));
+    TEST_ASSERT_NULL(strngr_byteset_compile(&set, null_str));
+
+    // Duplicates count once; delimiter sets fit the nibble tables
+    TEST_ASSERT_EQUAL_PTR(&set, strngr_byteset_compile(&set, STR_T_LITERAL(" \t\r\n;,;,")));
+    TEST_ASSERT_EQUAL_UINT32(6, set.count);
+    TEST_ASSERT_EQUAL_UINT32(1, set.nibble);
+
+    // Nine rows with different patterns do not
+    TEST_ASSERT_EQUAL_PTR(&set, strngr_byteset_compile(&set, STR_T_LITERAL("\x01\x12\x23\x34\x45\x56\x67\x78\x89")));
+    TEST_ASSERT_EQUAL_UINT32(9, set.count);
+    TEST_ASSERT_EQUAL_UINT32(0, set.nibble);
+}
+
+void test_strngr_strspn_and_strcspn_set_basic(void)
+{
+    strngr_byteset_t ws;
+    strngr_byteset_t delim;
+    str_t null_str = {0U, 0U, NULL, 0U};
+    str_t line     = STR_T_LITERAL("  \tGET /index.html HTTP/1.1\r\n");
+
+    strngr_byteset_compile(&ws, STR_T_LITERAL(" \t\r\n"));
+    strngr_byteset_compile(&delim, STR_T_LITERAL(" ?#\r\n"));
+
+    TEST_ASSERT_EQUAL_UINT32(3, strngr_strspn(line, &ws));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_strcspn_set(line, &ws));
+    TEST_ASSERT_EQUAL_UINT32(11, strngr_strcspn_set(strngr_strsub(line, 7, 100), &delim));
+    TEST_ASSERT_EQUAL_PTR(&line.str[6], strngr_strpbrk(strngr_strsub(line, 3, 100), &delim));
+
+    // Whole string in or out of the set
+    TEST_ASSERT_EQUAL_UINT32(4, strngr_strspn(STR_T_LITERAL(" \t \n"), &ws));
+    TEST_ASSERT_EQUAL_UINT32(5, strngr_strcspn_set(STR_T_LITERAL("abcde"), &ws));
+    TEST_ASSERT_NULL(strngr_strpbrk(STR_T_LITERAL("abcde"), &delim));
+
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_strspn(null_str, &ws));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_strcspn_set(null_str, &ws));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_strspn(line, NULL));
+    TEST_ASSERT_NULL(strngr_strpbrk(line, NULL));
+}
+
+void test_strngr_strspn_and_strcspn_set_match_naive(void)
+{
+    static char buf[300];
+    strngr_byteset_t set;
+    const str_t sets[] = {STR_T_LITERAL(","), STR_T_LITERAL(" \t\r\n"), STR_T_LITERAL(" \t\r\n;,=&"),
+                          STR_T_LITERAL("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_"),
+                          STR_T_LITERAL("\x01\x12\x23\x34\x45\x56\x67\x78\x89\x9A\xAB"), STR_T_LITERAL("\x80\xFF")};
+    str_t src = {sizeof(buf), sizeof(buf), buf, 0U};
+
+    for (uint32_t k = 0; k < (sizeof(sets) / sizeof(sets[0])); k++)
+    {
+        TEST_ASSERT_NOT_NULL(strngr_byteset_compile(&set, sets[k]));
+
+        // One member (or non-member) at every position of a long run of the other kind
+        for (uint32_t pos = 0; pos < sizeof(buf); pos += 7U)
+        {
+            memset(buf, '.', sizeof(buf));
+            buf[pos] = sets[k].str[sets[k].len - 1U];
+            TEST_ASSERT_EQUAL_UINT32(pos, strngr_strcspn_set(src, &set));
+
+            memset(buf, sets[k].str[0], sizeof(buf));
+            buf[pos] = '.';
+            TEST_ASSERT_EQUAL_UINT32(pos, strngr_strspn(src, &set));
+        }
+
+        // Every byte value, checked against the bitmap
+        for (uint32_t b = 0; b < 256U; b++)
+        {
+            char one[40];
+            memset(one, (char)b, sizeof(one));
+            str_t s = {sizeof(one), sizeof(one), one, 0U};
+            const uint32_t member = (memchr(sets[k].str, (int)b, sets[k].len) != NULL) ? 1U : 0U;
+            TEST_ASSERT_EQUAL_UINT32((member != 0U) ? 0U : 40U, strngr_strcspn_set(s, &set));
+            TEST_ASSERT_EQUAL_UINT32((member != 0U) ? 40U : 0U, strngr_strspn(s, &set));
+        }
+    }
+}
+
+void test_strngr_view_strspn_strcspn_set_strpbrk(void)
+{
+    strngr_byteset_t set;
+    str_view_t       kv = STR_VIEW_LITERAL("name=value&x=1");
+
+    strngr_byteset_compile(&set, STR_T_LITERAL("=&"));
+    TEST_ASSERT_EQUAL_UINT32(4, strngr_view_strcspn_set(kv, &set));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_view_strspn(kv, &set));
+    TEST_ASSERT_EQUAL_PTR(&kv.str[4], strngr_view_strpbrk(kv, &set));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_view_strspn(strngr_view_strsub(kv, 10, 100), &set));
+}
+
+// ============================================================================
+// Tests for case-insensitive compare, search and hashing
+// ============================================================================
+
+void test_strngr_strncasecmp_basic(void)
+{
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    TEST_ASSERT_EQUAL_INT32(0, strngr_strncasecmp(STR_T_LITERAL("Content-Length"), STR_T_LITERAL("content-LENGTH"), 14));
+    TEST_ASSERT_TRUE(strngr_strncasecmp(STR_T_LITERAL("abc"), STR_T_LITERAL("ABD"), 3) < 0);
+    TEST_ASSERT_TRUE(strngr_strncasecmp(STR_T_LITERAL("Abd"), STR_T_LITERAL("abc"), 3) > 0);
+    TEST_ASSERT_EQUAL_INT32(0, strngr_strncasecmp(STR_T_LITERAL("abcX"), STR_T_LITERAL("ABCy"), 3));
+
+    // Folded bytes are compared: 'Z' becomes 'z' (0x7A), which sorts after '_' (0x5F)
+    TEST_ASSERT_TRUE(strngr_strncasecmp(STR_T_LITERAL("Z"), STR_T_LITERAL("_"), 1) > 0);
+
+    // Only ASCII letters fold; neighbours of 'A'..'Z' and high bytes compare as they are
+    TEST_ASSERT_TRUE(strngr_strncasecmp(STR_T_LITERAL("@"), STR_T_LITERAL("`"), 1) != 0);
+    TEST_ASSERT_TRUE(strngr_strncasecmp(STR_T_LITERAL("["), STR_T_LITERAL("{"), 1) != 0);
+    TEST_ASSERT_TRUE(strngr_strncasecmp(STR_T_LITERAL("\xC1"), STR_T_LITERAL("\xE1"), 1) != 0);
+
+    TEST_ASSERT_EQUAL_INT32(0, strngr_strncasecmp(null_str, STR_T_LITERAL("a"), 1));
+}
+
+void test_strngr_strncasecmp_long_every_position(void)
+{
+    char a[100];
+    char b[100];
+    str_t sa = {sizeof(a), sizeof(a), a, 0U};
+    str_t sb = {sizeof(b), sizeof(b), b, 0U};
+
+    for (uint32_t i = 0; i < sizeof(a); i++)
+    {
+        a[i] = (char)('a' + (i % 26));
+        b[i] = (char)('A' + (i % 26));
+    }
+    TEST_ASSERT_EQUAL_INT32(0, strngr_strncasecmp(sa, sb, sizeof(a)));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_equal_nocase(sa, sb));
+
+    for (uint32_t i = 0; i < sizeof(a); i++)
+    {
+        const char saved = b[i];
+        b[i] = '#';
+        TEST_ASSERT_TRUE(strngr_strncasecmp(sa, sb, sizeof(a)) > 0);
+        TEST_ASSERT_EQUAL_INT32(0, strngr_strncasecmp(sa, sb, i));
+        TEST_ASSERT_EQUAL_UINT32(0, strngr_equal_nocase(sa, sb));
+        b[i] = saved;
+    }
+}
+
+void test_strngr_equal_nocase(void)
+{
+    str_t null_str = {0U, 0U, NULL, 0U};
+
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_equal_nocase(STR_T_LITERAL("Host"), STR_T_LITERAL("HOST")));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_equal_nocase(STR_T_LITERAL("Host"), STR_T_LITERAL("Hostname")));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_equal_nocase(null_str, null_str));
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_equal_nocase(null_str, STR_T_LITERAL("")));
+    TEST_ASSERT_EQUAL_UINT32(1, strngr_view_equal_nocase(STR_VIEW_LITERAL("x-Forwarded-FOR"),
+                                                         STR_VIEW_LITERAL("X-forwarded-for")));
+}
+
+void test_strngr_strcasestr_basic(void)
+{
+    char  hay[] = "Accept: */*\r\nCONTENT-type: text/html\r\n";
+    str_t h     = {38, 38, hay, 0U};
+
+    str_t result = strngr_strcasestr(h, STR_T_LITERAL("content-type:"));
+    TEST_ASSERT_EQUAL_PTR(&hay[13], result.str);
+    TEST_ASSERT_EQUAL_UINT32(25, result.len);
+
+    TEST_ASSERT_EQUAL_PTR(&hay[32], strngr_strcasestr(h, STR_T_LITERAL("HTML")).str);
+    TEST_ASSERT_EQUAL_PTR(&hay[0], strngr_strcasestr(h, STR_T_LITERAL("a")).str);
+    TEST_ASSERT_EQUAL_PTR(&hay[0], strngr_strcasestr(h, STR_T_LITERAL("")).str);
+    TEST_ASSERT_NULL(strngr_strcasestr(h, STR_T_LITERAL("content-length")).str);
+    TEST_ASSERT_NULL(strngr_strcasestr(STR_T_LITERAL("[x]"), STR_T_LITERAL("{X}")).str);
+
+    str_view_t v = strngr_view_strcasestr(STR_VIEW_LITERAL("Set-Cookie: ID=1; Path=/"), STR_VIEW_LITERAL("path"));
+    TEST_ASSERT_EQUAL_UINT32(6, v.len);
+}
+
+void test_strngr_strcasestr_long_and_adversarial(void)
+{
+    static char hay[4096];
+    char needle[48];
+
+    // A long needle in mixed case, placed once near the end
+    for (uint32_t i = 0; i < sizeof(hay); i++)
+    {
+        hay[i] = (char)(((i % 2U) != 0U) ? 'a' : 'B');
+    }
+    for (uint32_t i = 0; i < sizeof(needle); i++)
+    {
+        needle[i] = (char)('a' + (i % 26));
+        hay[4000 + i] = (char)('A' + (i % 26));
+    }
+    str_t h = {sizeof(hay), sizeof(hay), hay, 0U};
+    str_t n = {sizeof(needle), sizeof(needle), needle, 0U};
+    TEST_ASSERT_EQUAL_PTR(&hay[4000], strngr_strcasestr(h, n).str);
+
+    // Periodic haystack and needle that differ only in the last byte
+    memset(hay, 'A', sizeof(hay));
+    memset(needle, 'a', sizeof(needle));
+    needle[sizeof(needle) - 1] = 'b';
+    TEST_ASSERT_NULL(strngr_strcasestr(h, n).str);
+    n.len = 12;
+    needle[11] = 'B';
+    TEST_ASSERT_NULL(strngr_strcasestr(h, n).str);
+    hay[3000] = 'b';
+    TEST_ASSERT_EQUAL_PTR(&hay[2989], strngr_strcasestr(h, n).str);
+}
+
+void test_strngr_hash_nocase(void)
+{
+    const char *lower = "content-type-with-a-rather-long-header-name-for-the-wide-path";
+    const char *upper = "CONTENT-TYPE-WITH-A-RATHER-LONG-HEADER-NAME-FOR-THE-WIDE-PATH";
+
+    // Every length exercises the short, 16-byte and 48-byte lanes
+    for (uint32_t len = 0; len <= (uint32_t)strlen(lower); len++)
+    {
+        str_view_t a = {lower, len};
+        str_view_t b = {upper, len};
+        TEST_ASSERT_EQUAL_UINT64(strngr_view_hash_nocase(a, 0U), strngr_view_hash_nocase(b, 0U));
+        TEST_ASSERT_EQUAL_UINT64(strngr_view_hash(a, 0U), strngr_view_hash_nocase(a, 0U));
+    }
+
+    TEST_ASSERT_EQUAL_UINT64(strngr_hash_nocase(STR_T_LITERAL("Host")), strngr_hash_nocase(STR_T_LITERAL("hOST")));
+    TEST_ASSERT_TRUE(strngr_hash_nocase(STR_T_LITERAL("Host")) != strngr_hash_nocase(STR_T_LITERAL("Hosts")));
+    TEST_ASSERT_TRUE(strngr_hash_nocase(STR_T_LITERAL("[")) != strngr_hash_nocase(STR_T_LITERAL("{")));
+}
+
+// Case conversion and translation tests
+void test_strngr_to_lower_and_upper_basic(void)
+{
+    char  mem[64];
+    str_t s = strngr_new_s_ex(mem, sizeof(mem), "Hello, World! @[`{ 123 zZ", STRNGR_FLAG_TERMINATED);
+
+    strngr_to_lower(&s);
+    TEST_ASSERT_EQUAL_STRING("hello, world! @[`{ 123 zz", mem);
+    strngr_to_upper(&s);
+    TEST_ASSERT_EQUAL_STRING("HELLO, WORLD! @[`{ 123 ZZ", mem);
+
+    // NULL strings are ignored
+    strngr_to_lower(NULL);
+    strngr_to_upper_cpy(s, NULL);
+}
+
+void test_strngr_to_lower_and_upper_every_byte(void)
+{
+    char data[300];
+    char out[300];
+
+    // All 256 byte values at every offset of the wide blocks and the tail
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (char)(i * 7U);
+    }
+    for (uint32_t start = 0; start < 40; start++)
+    {
+        str_t s = {sizeof(data), sizeof(data) - start, &data[start], 0U};
+        memcpy(out, data, sizeof(out));
+        str_t d = {sizeof(out), 0U, out, 0U};
+
+        strngr_to_lower_cpy(s, &d);
+        TEST_ASSERT_EQUAL_UINT32(s.len, d.len);
+        for (uint32_t i = 0; i < s.len; i++)
+        {
+            const uint8_t b = (uint8_t)s.str[i];
+            TEST_ASSERT_EQUAL_HEX8(((b >= 'A') && (b <= 'Z')) ? (b + 32U) : b, (uint8_t)out[i]);
+        }
+
+        strngr_to_upper_cpy(s, &d);
+        for (uint32_t i = 0; i < s.len; i++)
+        {
+            const uint8_t b = (uint8_t)s.str[i];
+            TEST_ASSERT_EQUAL_HEX8(((b >= 'a') && (b <= 'z')) ? (b - 32U) : b, (uint8_t)out[i]);
+        }
+    }
+}
+
+void test_strngr_to_lower_cpy_bounds(void)
+{
+    char  small[6];
+    str_t dst;
+    strngr_new_ex(&dst, small, sizeof(small), STRNGR_FLAG_TERMINATED);
+
+    // Truncated like strngr_strcpy: capacity excludes the terminator
+    strngr_to_lower_cpy(STR_T_LITERAL("ABCDEFGH"), &dst);
+    TEST_ASSERT_EQUAL_UINT32(5, dst.len);
+    TEST_ASSERT_EQUAL_STRING("abcde", small);
+
+    strngr_to_upper_cpy(STR_T_LITERAL("xy"), &dst);
+    TEST_ASSERT_EQUAL_UINT32(2, dst.len);
+    TEST_ASSERT_EQUAL_STRING("XY", small);
+}
+
+void test_strngr_translate_tr_semantics(void)
+{
+    strngr_tr_t tr;
+    char        mem[64];
+    str_t       s = strngr_new_s_ex(mem, sizeof(mem), "hello world, abc-xyz", STRNGR_FLAG_TERMINATED);
+
+    // to shorter than from is padded with its last byte
+    TEST_ASSERT_EQUAL_PTR(&tr, strngr_tr_compile(&tr, STR_T_LITERAL("abcxyz"), STR_T_LITERAL("ABC_")));
+    strngr_translate(&s, &tr);
+    TEST_ASSERT_EQUAL_UINT32(20, s.len);
+    TEST_ASSERT_EQUAL_STRING("hello world, ABC-___", mem);
+    TEST_ASSERT_EQUAL_HEX32((1U << 6U) | (1U << 7U), tr.rows);
+
+    // Later mappings of the same byte win
+    TEST_ASSERT_EQUAL_PTR(&tr, strngr_tr_compile(&tr, STR_T_LITERAL("oo "), STR_T_LITERAL("01.")));
+    strngr_translate(&s, &tr);
+    TEST_ASSERT_EQUAL_STRING("hell1.w1rld,.ABC-___", mem);
+
+    TEST_ASSERT_NULL(strngr_tr_compile(&tr, STR_T_LITERAL("a"), STR_T_LITERAL("")));
+    TEST_ASSERT_NULL(strngr_tr_compile(NULL, STR_T_LITERAL("a"), STR_T_LITERAL("b")));
+    TEST_ASSERT_NULL(strngr_tr_compile_table(&tr, NULL));
+
+    // An identity table touches no rows
+    uint8_t table[256];
+    for (uint32_t b = 0; b < 256; b++)
+    {
+        table[b] = (uint8_t)b;
+    }
+    strngr_tr_compile_table(&tr, table);
+    TEST_ASSERT_EQUAL_HEX32(0, tr.rows);
+    strngr_translate(&s, &tr);
+    TEST_ASSERT_EQUAL_STRING("hell1.w1rld,.ABC-___", mem);
+}
+
+void test_strngr_translate_matches_table(void)
+{
+    uint8_t     table[256];
+    strngr_tr_t tr;
+    char        data[333];
+    char        out[333];
+
+    // A dense table (every row changes) and a sparse one (two rows change)
+    for (uint32_t dense = 0; dense < 2; dense++)
+    {
+        for (uint32_t b = 0; b < 256; b++)
+        {
+            table[b] = (uint8_t)((dense != 0U) ? (b * 167U + 13U) : b);
+        }
+        if (dense == 0U)
+        {
+            table[0x00] = 0xFF;
+            table[0x0A] = ' ';
+            table[0xE9] = 'e';
+        }
+        strngr_tr_compile_table(&tr, table);
+
+        for (uint32_t i = 0; i < sizeof(data); i++)
+        {
+            data[i] = (char)((i * 31U) ^ (i >> 3U));
+        }
+        for (uint32_t len = 0; len <= sizeof(data); len += 37)
+        {
+            str_t s = {sizeof(data), len, data, 0U};
+            str_t d = {sizeof(out), 0U, out, 0U};
+            strngr_translate_cpy(s, &d, &tr);
+            TEST_ASSERT_EQUAL_UINT32(len, d.len);
+            for (uint32_t i = 0; i < len; i++)
+            {
+                TEST_ASSERT_EQUAL_HEX8(table[(uint8_t)data[i]], (uint8_t)out[i]);
+            }
+        }
+
+        // In place over the whole buffer
+        str_t s = {sizeof(data), sizeof(data), data, 0U};
+        memcpy(out, data, sizeof(out));
+        strngr_translate(&s, &tr);
+        for (uint32_t i = 0; i < sizeof(data); i++)
+        {
+            TEST_ASSERT_EQUAL_HEX8(table[(uint8_t)out[i]], (uint8_t)data[i]);
+        }
+    }
+}
+
+// Trim and collapse tests
+void test_strngr_trim_basic(void)
+{
+    char  mem[64];
+    str_t s = strngr_new_s(mem, sizeof(mem), " \t value \r\n");
+
+    str_t t = strngr_trim(s, NULL);
+    TEST_ASSERT_EQUAL_PTR(&mem[3], t.str);
+    TEST_ASSERT_EQUAL_UINT32(5, t.len);
+    TEST_ASSERT_EQUAL_UINT32(0, t.term & STRNGR_FLAG_TERMINATED);
+
+    t = strngr_ltrim(s, NULL);
+    TEST_ASSERT_EQUAL_PTR(&mem[3], t.str);
+    TEST_ASSERT_EQUAL_UINT32(8, t.len);
+    TEST_ASSERT_EQUAL_UINT32(s.term & STRNGR_FLAG_TERMINATED, t.term & STRNGR_FLAG_TERMINATED);
+
+    t = strngr_rtrim(s, NULL);
+    TEST_ASSERT_EQUAL_PTR(mem, t.str);
+    TEST_ASSERT_EQUAL_UINT32(8, t.len);
+
+    // All whitespace, empty and missing strings
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_trim(STR_T_LITERAL(" \t\v\f "), NULL).len);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_rtrim(STR_T_LITERAL(" \t\v\f "), NULL).len);
+    TEST_ASSERT_EQUAL_UINT32(0, strngr_ltrim(STR_T_LITERAL(""), NULL).len);
+    str_t none = {0U, 0U, NULL, 0U};
+    TEST_ASSERT_NULL(strngr_trim(none, NULL).str);
+}
+
+void test_strngr_trim_custom_set_and_long_runs(void)
+{
+    strngr_byteset_t set;
+    strngr_byteset_compile(&set, STR_T_LITERAL("\"' "));
+    str_t t = strngr_trim(STR_T_LITERAL("  \"quoted 'cell'\"\t"), &set);
+    TEST_ASSERT_EQUAL_UINT32(15, t.len);
+    TEST_ASSERT_EQUAL_MEMORY("quoted 'cell'\"\t", t.str, t.len);
+
+    // Runs longer than the vector blocks on both sides, at every alignment
+    char buf[200];
+    for (uint32_t pad = 0; pad < 80; pad += 3)
+    {
+        memset(buf, ' ', sizeof(buf));
+        buf[pad]       = 'x';
+        buf[pad + 40U] = 'y';
+        buf[pad + 10U] = '\n';
+        str_view_t v   = {buf, sizeof(buf)};
+
+        const str_view_t r = strngr_view_trim(v, NULL);
+        TEST_ASSERT_EQUAL_PTR(&buf[pad], r.str);
+        TEST_ASSERT_EQUAL_UINT32(41, r.len);
+        TEST_ASSERT_EQUAL_UINT32(pad + 41U, strngr_view_rtrim(v, NULL).len);
+        TEST_ASSERT_EQUAL_UINT32(sizeof(buf) - pad, strngr_view_ltrim(v, NULL).len);
+    }
+}
+
+void test_strngr_collapse_ws_basic(void)
+{
+    char  mem[64];
+    str_t s = strngr_new_s_ex(mem, sizeof(mem), "  a \t\tb\r\n\r\nc  ", STRNGR_FLAG_TERMINATED);
+
+    strngr_collapse_ws(&s, NULL);
+    TEST_ASSERT_EQUAL_UINT32(7, s.len);
+    TEST_ASSERT_EQUAL_STRING(" a b c ", mem);
+
+    // Custom set: each run of separators becomes one space
+    strngr_byteset_t set;
+    strngr_byteset_compile(&set, STR_T_LITERAL(",;"));
+    s = strngr_new_s_ex(mem, sizeof(mem), "a,,;b;c, d", STRNGR_FLAG_TERMINATED);
+    strngr_collapse_ws(&s, &set);
+    TEST_ASSERT_EQUAL_STRING("a b c  d", mem);
+
+    strngr_collapse_ws(NULL, NULL);
+}
+
+void test_strngr_collapse_ws_matches_naive(void)
+{
+    char data[300];
+    char expect[300];
+
+    for (uint32_t seed = 1; seed < 60; seed++)
+    {
+        uint32_t x = seed;
+        for (uint32_t i = 0; i < sizeof(data); i++)
+        {
+            x       = (x * 1103515245U) + 12345U;
+            data[i] = " \t\nab\r "[(x >> 16U) % 7U];
+        }
+        const uint32_t len = (seed * 37U) % (uint32_t)sizeof(data);
+
+        uint32_t w    = 0;
+        uint32_t prev = 0;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            const uint32_t ws = ((data[i] == ' ') || (data[i] == '\t') || (data[i] == '\n') || (data[i] == '\r'));
+            if ((ws == 0U) || (prev == 0U))
+            {
+                expect[w] = (ws != 0U) ? ' ' : data[i];
+                w++;
+            }
+            prev = ws;
+        }
+
+        str_t s = {sizeof(data), len, data, 0U};
+        strngr_collapse_ws(&s, NULL);
+        TEST_ASSERT_EQUAL_UINT32(w, s.len);
+        TEST_ASSERT_EQUAL_MEMORY(expect, data, w);
+    }
+}